@@ -12,7 +12,7 @@ extern "C"
 #include <iostream>
 #include <fstream>
 #include "sde-init.H"
-#include "sde-emulating.H"
+#include "sde-emulated-index.H"
 
 using namespace std;
 
@@ -26,6 +26,8 @@ static UINT64 ins_count   = 0;
 static UINT64 agen_icount = 0;
 static UINT64 emu_icount  = 0;
 
+static INSTLIB::EMULATED_PC_INDEX emulated_index;
+
 VOID mem_read(THREADID tid, ADDRINT addr, UINT32 size) { read_count += size; }
 
 VOID mem_write(THREADID tid, ADDRINT addr, UINT32 size) { write_count += size; }
@@ -58,6 +60,10 @@ VOID emu_count(THREADID tid, UINT32 inss) { emu_icount += inss; }
 
 VOID instrument_trace(TRACE trace, VOID* v)
 {
+    vector<BOOL> emulated;
+    emulated_index.queryTrace(trace, emulated);
+    size_t i = 0;
+
     for (BBL bbl = TRACE_BblHead(trace); BBL_Valid(bbl); bbl = BBL_Next(bbl))
     {
         UINT32 emu = 0;
@@ -66,9 +72,9 @@ VOID instrument_trace(TRACE trace, VOID* v)
         INS_InsertCall(head, IPOINT_BEFORE, (AFUNPTR)icount, IARG_THREAD_ID, IARG_UINT32,
                        BBL_NumIns(bbl), IARG_END);
 
-        for (INS ins = BBL_InsHead(bbl); INS_Valid(ins); ins = INS_Next(ins))
+        for (INS ins = BBL_InsHead(bbl); INS_Valid(ins); ins = INS_Next(ins), i++)
         {
-            if (INSTLIB::sde_is_emulated(INS_Address(ins)))
+            if (emulated[i])
             {
                 emu++;
             }
@@ -145,6 +151,9 @@ int main(int argc, char* argv[])
     sde_pin_init(argc, argv);
     sde_init();
 
+    // forget the emulated instructions of the unloaded images
+    emulated_index.activate();
+
     // register Trace to be called to instrument instructions
     TRACE_AddInstrumentFunction(instrument_trace, 0);
 
@@ -0,0 +1,30 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that detects AVX-SSE transitions and
+  reports them per basic block, e.g.:
+    sde64 -t avx-sse-transition.so -- <application>
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "avx-sse-transition.H"
+
+avx_sse_transition::AVX_SSE_TRANSITION avxSseTransition;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate transition detection.
+    avxSseTransition.activate();
+
+    PIN_StartProgram(); // Never returns
+    return 0;
+}
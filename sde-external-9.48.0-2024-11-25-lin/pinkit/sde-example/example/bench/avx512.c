@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2024 Intel Corporation.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Benchmark workload: AVX-512 integer and floating-point kernels with
+// masked tails and gathers. The kernels are compiled for AVX-512 with a
+// target attribute; run the workload under SDE emulation on processors
+// without AVX-512.
+//   bench-avx512 [<scale>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <immintrin.h>
+
+#define N 4099 // not a multiple of the vector length
+
+__attribute__((target("avx512f"))) static void fma_kernel(float* y, const float* x, float a)
+{
+    __m512 va = _mm512_set1_ps(a);
+    int i;
+    for (i = 0; i + 16 <= N; i += 16)
+        _mm512_storeu_ps(y + i, _mm512_fmadd_ps(va, _mm512_loadu_ps(x + i),
+                                                _mm512_loadu_ps(y + i)));
+    __mmask16 m = (__mmask16)((1u << (N - i)) - 1);
+    _mm512_mask_storeu_ps(y + i, m, _mm512_fmadd_ps(va, _mm512_maskz_loadu_ps(m, x + i),
+                                                    _mm512_maskz_loadu_ps(m, y + i)));
+}
+
+__attribute__((target("avx512f"))) static uint32_t gather_kernel(const uint32_t* table,
+                                                                 const int32_t* idx)
+{
+    __m512i sum = _mm512_setzero_si512();
+    for (int i = 0; i + 16 <= N; i += 16)
+    {
+        __m512i vi = _mm512_loadu_si512(idx + i);
+        sum        = _mm512_add_epi32(sum, _mm512_i32gather_epi32(vi, table, 4));
+    }
+    return _mm512_reduce_add_epi32(sum);
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned scale = argc > 1 ? atoi(argv[1]) : 1;
+    static float x[N], y[N];
+    static uint32_t table[N];
+    static int32_t idx[N];
+    uint64_t seed = 7;
+    for (int i = 0; i < N; i++)
+    {
+        seed     = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        x[i]     = (float)(i % 17) * 0.25f;
+        y[i]     = 1.0f;
+        table[i] = (uint32_t)(seed >> 32);
+        idx[i]   = (int32_t)((seed >> 20) % N);
+    }
+
+    uint32_t isum = 0;
+    for (unsigned rep = 0; rep < scale * 20000; rep++)
+    {
+        fma_kernel(y, x, 1.0f / 1024);
+        isum += gather_kernel(table, idx);
+    }
+    double fsum = 0;
+    for (int i = 0; i < N; i++)
+        fsum += y[i];
+    printf("checksum %x %.9g\n", isum, fsum);
+    return 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2024 Intel Corporation.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Benchmark workload: threads doing short compute phases separated by
+// barriers.
+//   bench-barrier [<scale> [<threads>]]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#define MAX_THREADS 64
+
+static pthread_barrier_t barrier;
+static unsigned numPhases;
+static uint64_t results[MAX_THREADS];
+
+static void* worker(void* arg)
+{
+    uintptr_t id = (uintptr_t)arg;
+    uint64_t x   = id + 1;
+    for (unsigned phase = 0; phase < numPhases; phase++)
+    {
+        for (unsigned i = 0; i < 2000; i++)
+            x = x * 6364136223846793005ULL + phase;
+        pthread_barrier_wait(&barrier);
+    }
+    results[id] = x;
+    return NULL;
+}
+
+int main(int argc, char* argv[])
+{
+    unsigned scale    = argc > 1 ? atoi(argv[1]) : 1;
+    unsigned nthreads = argc > 2 ? atoi(argv[2]) : 8;
+    if (nthreads < 1 || nthreads > MAX_THREADS)
+        return 1;
+    numPhases = scale * 2000;
+
+    pthread_t threads[MAX_THREADS];
+    pthread_barrier_init(&barrier, NULL, nthreads);
+    for (uintptr_t t = 0; t < nthreads; t++)
+        pthread_create(&threads[t], NULL, worker, (void*)t);
+    uint64_t sum = 0;
+    for (unsigned t = 0; t < nthreads; t++)
+    {
+        pthread_join(threads[t], NULL);
+        sum += results[t];
+    }
+    pthread_barrier_destroy(&barrier);
+    printf("checksum %llx\n", (unsigned long long)sum);
+    return 0;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (C) 2024 Intel Corporation.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Benchmark workload: many short basic blocks with data-dependent,
+// poorly predictable branches and an indirect call per iteration.
+//   bench-branchy [<scale>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+static uint64_t f0(uint64_t x) { return x * 3 + 1; }
+static uint64_t f1(uint64_t x) { return x >> 1; }
+static uint64_t f2(uint64_t x) { return x ^ (x << 7); }
+static uint64_t f3(uint64_t x) { return x + 0x9e3779b97f4a7c15ULL; }
+
+int main(int argc, char* argv[])
+{
+    typedef uint64_t (*FUNC)(uint64_t);
+    const FUNC funcs[4] = {f0, f1, f2, f3};
+    unsigned scale      = argc > 1 ? atoi(argv[1]) : 1;
+    uint64_t seed       = 42;
+    uint64_t sum        = 0;
+    for (uint64_t i = 0; i < (uint64_t)scale * 2000000; i++)
+    {
+        seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        uint32_t r = seed >> 40;
+        if (r & 1)
+            sum += r;
+        else if (r & 2)
+            sum ^= r;
+        else if (r & 4)
+            sum -= r >> 3;
+        else
+            sum = (sum << 1) | (sum >> 63);
+        switch ((r >> 3) & 7)
+        {
+            case 0: sum += 1; break;
+            case 1: sum += 3; break;
+            case 2: sum ^= 5; break;
+            case 3: sum -= 7; break;
+            case 4: sum += 11; break;
+            default: break;
+        }
+        sum = funcs[(r >> 6) & 3](sum);
+    }
+    printf("checksum %llx\n", (unsigned long long)sum);
+    return 0;
+}
@@ -0,0 +1,40 @@
+/*
+ * Copyright (C) 2024 Intel Corporation.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Benchmark workload: repeated load, call and unload of a shared object,
+// which makes the tools instrument and drop its image every time.
+//   bench-dlopen-storm <shared-object> [<scale>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <dlfcn.h>
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s <shared-object> [<scale>]\n", argv[0]);
+        return 1;
+    }
+    unsigned scale    = argc > 2 ? atoi(argv[2]) : 1;
+    unsigned long sum = 0;
+    for (unsigned i = 0; i < scale * 200; i++)
+    {
+        void* handle = dlopen(argv[1], RTLD_NOW | RTLD_LOCAL);
+        if (!handle)
+        {
+            fprintf(stderr, "%s\n", dlerror());
+            return 1;
+        }
+        unsigned long (*work)(unsigned long) =
+            (unsigned long (*)(unsigned long))dlsym(handle, "bench_dso_work");
+        if (!work)
+            return 1;
+        sum += work(i);
+        dlclose(handle);
+    }
+    printf("checksum %lx\n", sum);
+    return 0;
+}
@@ -0,0 +1,380 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+// Native benchmark of the data structures used by the tools on every
+// memory reference:
+//   CACHE<...>::Access           pin_cache.H
+//   RD_Treap, RD_LogRR           reuse_distance.H
+//   COMPRESSOR_COUNTER           pin_profile.H
+//
+//   bench-ds [-refs <n>] [-ws <bytes>,...] [-streams <name>,...]
+//            [-structs <name>,...] [-trace <file>]
+//
+// Every structure is driven by every address stream for every working-set
+// size. A stream is generated before the measurement, so only the
+// structure is timed. Every measurement runs in a child process so its
+// memory use is the growth of the resident set of that process.
+//
+// The synthetic streams are 'seq' (8-byte stride), 'random' (uniform over
+// the cache lines) and 'hot' (90% of the references to 10% of the lines).
+// A recorded stream is read with -trace from a text file with one
+// hexadecimal address per line; its working set is the number of distinct
+// cache lines it references.
+//
+// RD_Treap is not in the default structures: beyond 1MB of working set it
+// takes about 10 microseconds per reference at 100K references and about
+// 100 at the default 1M, so one measurement takes minutes. Select it with
+// -structs, e.g. -structs rd-treap -refs 100000.
+//
+// The output is CSV on stdout:
+//   structure,stream,working set,references,ns/reference,memory KB,result
+// where the result is the hit rate of the caches, the mean log2 reuse
+// distance of the reuse distance structures and the number of keys of
+// the profile.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <climits>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#include <string>
+#include <vector>
+#include <set>
+#include <fstream>
+#include <sstream>
+#include <iostream>
+#include <iomanip>
+
+#include "pin.H"
+#include "pin_util.H"
+
+typedef UINT64 CACHE_STATS;
+
+#include "pin_cache.H"
+#include "pin_profile.H"
+#include "reuse_distance.H"
+
+namespace
+{
+const UINT32 LINE_SHIFT = 6;
+
+typedef std::vector<ADDRINT> STREAM;
+
+// 32KB 8-way and 8MB 16-way caches with 64-byte lines.
+typedef CACHE_ROUND_ROBIN(64, 8, CACHE_ALLOC::STORE_ALLOCATE) L1_CACHE;
+typedef CACHE_ROUND_ROBIN(8192, 16, CACHE_ALLOC::STORE_ALLOCATE) LLC_CACHE;
+
+typedef COMPRESSOR_COUNTER<ADDRINT, UINT32, COUNTER_ARRAY<UINT64, 2> > PROFILE_COUNTER;
+
+const char* const STRUCTS[] = {"cache-l1", "cache-llc", "rd-treap", "rd-logrr", "profile"};
+const char* const DEFAULT_STRUCTS[] = {"cache-l1", "cache-llc", "rd-logrr", "profile"};
+const char* const STREAMS[] = {"seq", "random", "hot"};
+
+// xorshift64*, independent of the C library.
+struct RANDOM
+{
+    UINT64 state;
+    RANDOM(UINT64 seed) : state(seed) {}
+    UINT64 next()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return state * 2685821657736338717ULL;
+    }
+};
+
+// Addresses start above the null page: RD_LogRR uses 0 for empty slots.
+const ADDRINT BASE = 0x10000000;
+
+VOID makeStream(const std::string& name, UINT64 ws, UINT64 refs, STREAM& s)
+{
+    s.resize(refs);
+    UINT64 lines = ws >> LINE_SHIFT;
+    if (lines == 0)
+        lines = 1;
+    RANDOM rnd(ws * 31 + name.size());
+    for (UINT64 i = 0; i < refs; i++)
+    {
+        if (name == "seq")
+            s[i] = BASE + (i * 8) % ws;
+        else if (name == "random")
+            s[i] = BASE + ((rnd.next() % lines) << LINE_SHIFT);
+        else // hot
+        {
+            UINT64 hotLines = lines / 10 ? lines / 10 : 1;
+            UINT64 r        = rnd.next();
+            UINT64 line     = (r % 10) ? (r >> 8) % hotLines : (r >> 8) % lines;
+            s[i]            = BASE + (line << LINE_SHIFT);
+        }
+    }
+}
+
+// Read a recorded stream, returns its working set in bytes.
+UINT64 readTrace(const std::string& fileName, STREAM& s)
+{
+    std::ifstream in(fileName.c_str());
+    if (!in.is_open())
+    {
+        std::cerr << "Error: cannot open " << fileName << std::endl;
+        exit(1);
+    }
+    std::set<ADDRINT> lines;
+    std::string line;
+    while (getline(in, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+        ADDRINT addr = strtoull(line.c_str(), NULL, 16);
+        s.push_back(addr);
+        lines.insert(addr >> LINE_SHIFT);
+    }
+    if (s.empty())
+    {
+        std::cerr << "Error: no addresses in " << fileName << std::endl;
+        exit(1);
+    }
+    return UINT64(lines.size()) << LINE_SHIFT;
+}
+
+UINT64 residentKB()
+{
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (!f)
+        return 0;
+    unsigned long size = 0, resident = 0;
+    if (fscanf(f, "%lu %lu", &size, &resident) != 2)
+        resident = 0;
+    fclose(f);
+    return UINT64(resident) * sysconf(_SC_PAGESIZE) / 1024;
+}
+
+UINT64 nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return UINT64(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+struct RESULT
+{
+    double nsPerRef;
+    UINT64 memoryKB;
+    double result;
+};
+
+// Run one structure on a stream. The structure is created after the
+// baseline of the resident set is taken.
+template <class CACHE_TYPE> VOID runCache(UINT32 size, UINT32 assoc, const STREAM& s, RESULT& r)
+{
+    UINT64 before = residentKB();
+    CACHE_TYPE* c = new CACHE_TYPE("bench", size, 1 << LINE_SHIFT, assoc);
+    UINT64 start  = nowNs();
+    UINT64 hits   = 0;
+    for (size_t i = 0; i < s.size(); i++)
+        hits += c->Access(s[i], 8, CACHE_BASE::ACCESS_TYPE_LOAD);
+    r.nsPerRef = double(nowNs() - start) / s.size();
+    r.memoryKB = residentKB() - before;
+    r.result   = double(hits) / s.size();
+    delete c;
+}
+
+VOID runRd(RD* rd, UINT64 before, const STREAM& s, RESULT& r)
+{
+    // The first reference allocates the tables of RD_LogRR (128MB); make
+    // it outside of the measurement, with a line that is not in the
+    // stream so the distances of the stream do not change.
+    rd->reference(~ADDRINT(0) << LINE_SHIFT);
+    UINT64 start = nowNs();
+    UINT64 sum   = 0;
+    for (size_t i = 0; i < s.size(); i++)
+        sum += rd->reference(s[i] >> LINE_SHIFT << LINE_SHIFT);
+    r.nsPerRef = double(nowNs() - start) / s.size();
+    r.memoryKB = residentKB() - before;
+    r.result   = double(sum) / s.size();
+    delete rd;
+}
+
+VOID runProfile(const STREAM& s, RESULT& r)
+{
+    UINT64 before       = residentKB();
+    PROFILE_COUNTER* pc = new PROFILE_COUNTER();
+    UINT64 start        = nowNs();
+    UINT32 keys         = 0;
+    for (size_t i = 0; i < s.size(); i++)
+    {
+        UINT32 idx = pc->Map(s[i] >> LINE_SHIFT);
+        (*pc)[idx][0]++;
+        if (idx >= keys)
+            keys = idx + 1;
+    }
+    r.nsPerRef = double(nowNs() - start) / s.size();
+    r.memoryKB = residentKB() - before;
+    r.result   = keys;
+    delete pc;
+}
+
+VOID runStruct(const std::string& name, const STREAM& s, RESULT& r)
+{
+    if (name == "cache-l1")
+        runCache<L1_CACHE>(32 * KILO, 8, s, r);
+    else if (name == "cache-llc")
+        runCache<LLC_CACHE>(8 * MEGA, 16, s, r);
+    else if (name == "rd-treap")
+    {
+        UINT64 before = residentKB();
+        runRd(new RD_Treap(), before, s, r);
+    }
+    else if (name == "rd-logrr")
+    {
+        UINT64 before = residentKB();
+        runRd(new RD_LogRR(), before, s, r);
+    }
+    else
+        runProfile(s, r);
+}
+
+// Run a measurement in a child process so the resident set of the
+// structure does not include the memory freed by earlier measurements.
+bool measure(const std::string& name, const STREAM& s, RESULT& r)
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+        return false;
+    pid_t pid = fork();
+    if (pid < 0)
+        return false;
+    if (pid == 0)
+    {
+        close(fds[0]);
+        RESULT cr;
+        runStruct(name, s, cr);
+        ssize_t n = write(fds[1], &cr, sizeof(cr));
+        _exit(n == ssize_t(sizeof(cr)) ? 0 : 1);
+    }
+    close(fds[1]);
+    ssize_t n = read(fds[0], &r, sizeof(r));
+    close(fds[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return n == ssize_t(sizeof(r)) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+std::vector<std::string> split(const std::string& list)
+{
+    std::vector<std::string> items;
+    std::istringstream is(list);
+    std::string item;
+    while (getline(is, item, ','))
+        if (!item.empty())
+            items.push_back(item);
+    return items;
+}
+
+bool known(const std::string& name, const char* const* names, size_t num)
+{
+    for (size_t i = 0; i < num; i++)
+        if (name == names[i])
+            return true;
+    return false;
+}
+
+VOID usage()
+{
+    std::cerr << "Usage: bench-ds [-refs <n>] [-ws <bytes>,...] [-streams <name>,...]"
+              << " [-structs <name>,...] [-trace <file>]" << std::endl;
+    exit(1);
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    UINT64 refs = 1000000;
+    std::vector<UINT64> workingSets;
+    std::vector<std::string> streams(STREAMS, STREAMS + 3);
+    std::vector<std::string> structs(DEFAULT_STRUCTS, DEFAULT_STRUCTS + 4);
+    std::string traceFile;
+
+    for (INT32 i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (i + 1 >= argc)
+            usage();
+        std::string value = argv[++i];
+        if (arg == "-refs")
+            refs = strtoull(value.c_str(), NULL, 0);
+        else if (arg == "-ws")
+        {
+            std::vector<std::string> items = split(value);
+            for (size_t j = 0; j < items.size(); j++)
+                workingSets.push_back(strtoull(items[j].c_str(), NULL, 0));
+        }
+        else if (arg == "-streams")
+            streams = split(value);
+        else if (arg == "-structs")
+            structs = split(value);
+        else if (arg == "-trace")
+            traceFile = value;
+        else
+            usage();
+    }
+    if (refs == 0)
+        usage();
+    if (workingSets.empty())
+        for (UINT64 ws = 4 * KILO; ws <= 256 * UINT64(MEGA); ws *= 4)
+            workingSets.push_back(ws);
+    for (size_t i = 0; i < streams.size(); i++)
+        if (!known(streams[i], STREAMS, 3))
+        {
+            std::cerr << "Error: unknown stream " << streams[i] << std::endl;
+            exit(1);
+        }
+    for (size_t i = 0; i < structs.size(); i++)
+        if (!known(structs[i], STRUCTS, 5))
+        {
+            std::cerr << "Error: unknown structure " << structs[i] << std::endl;
+            exit(1);
+        }
+
+    std::cout << "structure,stream,working set,references,ns/reference,memory KB,result"
+              << std::endl;
+    std::cout << std::fixed;
+    bool failed = false;
+    STREAM s;
+
+    // Recorded stream, or every synthetic stream and working set.
+    std::vector<std::pair<std::string, UINT64> > runs;
+    if (!traceFile.empty())
+        runs.push_back(std::make_pair(std::string("trace"), readTrace(traceFile, s)));
+    else
+        for (size_t i = 0; i < streams.size(); i++)
+            for (size_t j = 0; j < workingSets.size(); j++)
+                runs.push_back(std::make_pair(streams[i], workingSets[j]));
+
+    for (size_t i = 0; i < runs.size(); i++)
+    {
+        if (traceFile.empty())
+            makeStream(runs[i].first, runs[i].second, refs, s);
+        for (size_t j = 0; j < structs.size(); j++)
+        {
+            RESULT r;
+            if (!measure(structs[j], s, r))
+            {
+                std::cerr << "Error: " << structs[j] << " failed on " << runs[i].first
+                          << std::endl;
+                failed = true;
+                continue;
+            }
+            std::cout << structs[j] << ',' << runs[i].first << ',' << runs[i].second << ','
+                      << s.size() << ',' << std::setprecision(2) << r.nsPerRef << ','
+                      << r.memoryKB << ',' << std::setprecision(4) << r.result << std::endl;
+        }
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,13 @@
+/*
+ * Copyright (C) 2024 Intel Corporation.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Shared object loaded and unloaded by the dlopen-storm workload.
+
+unsigned long bench_dso_work(unsigned long x)
+{
+    for (int i = 0; i < 100; i++)
+        x = x * 6364136223846793005UL + i;
+    return x;
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2024 Intel Corporation.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Benchmark workload: dependent loads through a random cyclic permutation
+// larger than the caches.
+//   bench-pointer-chase [<scale>]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+int main(int argc, char* argv[])
+{
+    unsigned scale = argc > 1 ? atoi(argv[1]) : 1;
+    size_t n       = 1 << 22;
+    size_t* next   = malloc(n * sizeof(size_t));
+    if (!next)
+        return 1;
+
+    // Sattolo's algorithm with a fixed LCG gives one cycle through all
+    // the elements.
+    uint64_t seed = 12345;
+    for (size_t i = 0; i < n; i++)
+        next[i] = i;
+    for (size_t i = n - 1; i > 0; i--)
+    {
+        seed     = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+        size_t j = (seed >> 33) % i;
+        size_t t = next[i];
+        next[i]  = next[j];
+        next[j]  = t;
+    }
+
+    size_t p     = 0;
+    uint64_t sum = 0;
+    for (uint64_t step = 0; step < (uint64_t)scale * 4000000; step++)
+    {
+        p = next[p];
+        sum += p;
+    }
+    printf("checksum %llx\n", (unsigned long long)sum);
+    free(next);
+    return 0;
+}
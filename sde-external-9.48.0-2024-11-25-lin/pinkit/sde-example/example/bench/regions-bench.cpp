@@ -0,0 +1,305 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+// Native harness of the region controllers CONTROL_IREGIONS
+// (regions_control.H) and CONTROL_PCREGIONS (pcregions_control.H). The
+// controller headers are compiled unchanged against the stand-ins of
+// pin.H and control_manager.H in bench/mock.
+//
+//   bench-regions [-regions <n>] [-threads <n>] [-warmup] [-keep]
+//                 [-regions-file <file>] [-pcregions-file <file>]
+//
+// Synthetic regions files with <n> regions (100000 by default) spread
+// over <n> threads are written to a temporary directory, or the given
+// files are used. With -warmup, the regions have warm-up regions
+// (regions:warmup for CONTROL_IREGIONS, warm-up records read with
+// pcregions:merge_warmup for CONTROL_PCREGIONS). For each controller,
+// the setup time is the time to construct and activate the controller:
+// read the file, check the overlaps and make the controller chains. The
+// events of the chains are then dispatched the way CONTROL_MANAGER does:
+// the triggered region is set for every event and the region info
+// callback is called for every start event.
+//
+// The synthetic regions do not overlap, so every region must make its
+// chains and every event must be accepted; the region IDs of the
+// synthetic regions file are checked as well. The program exits with 1 if
+// a check fails.
+//
+// The output is CSV on stdout:
+//   controller,regions,chains,setup ms,events,ns/event
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "pin.H"
+#include "control_manager.H"
+#include "../pcregions_control.H"
+
+using namespace CONTROLLER;
+
+namespace
+{
+struct RESULT
+{
+    UINT64 regions;
+    UINT64 chains;
+    double setupMs;
+    UINT64 events;
+    double nsPerEvent;
+};
+
+UINT64 nowNs()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return UINT64(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+}
+
+const UINT64 REGION_LENGTH = 100000;
+
+// Regions of the same length with gaps of the same length, so the
+// warm-up of a region does not overlap the previous region.
+VOID writeRegions(const string& fileName, UINT32 num, UINT32 threads)
+{
+    ofstream os(fileName.c_str());
+    os << "comment,thread-id,region-id,simulation-region-start-icount,"
+       << "simulation-region-end-icount,region-weight" << endl;
+    for (UINT32 i = 0; i < num; i++)
+    {
+        UINT64 start = (UINT64(i / threads) * 2 + 1) * REGION_LENGTH;
+        os << "#region " << i + 1 << endl;
+        os << "cluster " << i << " from slice " << i << "," << i % threads << "," << i + 1
+           << "," << start << "," << start + REGION_LENGTH << "," << 1.0 / num << endl;
+    }
+}
+
+// Every region has its own start and end PCs. With -warmup, every
+// simulation region has a warm-up region ending where the region starts,
+// and the regions are read with pcregions:merge_warmup.
+VOID writePcRegions(const string& fileName, UINT32 num, UINT32 threads, BOOL warmup)
+{
+    ofstream os(fileName.c_str());
+    os << "comment,thread-id,region-id,start-pc,start-image-name,start-image-offset,"
+       << "start-pc-count,end-pc,end-image-name,end-image-offset,end-pc-count,"
+       << "end-pc-relative-count,region-length,region-weight,region-multiplier,region-type"
+       << endl;
+    for (UINT32 i = 0; i < num; i++)
+    {
+        UINT32 rid        = i + 1;
+        UINT32 tid        = i % threads;
+        ADDRINT startPc   = 0x401000 + 0x40 * UINT64(i);
+        ADDRINT endPc     = startPc + 0x10;
+        ADDRINT warmupPc  = startPc + 0x20;
+        const char* image = "bench";
+        if (warmup)
+            os << "Warmup for regionid " << rid << "," << tid << "," << num + rid << ",0x"
+               << hex << warmupPc << "," << image << ",0x" << warmupPc - 0x400000 << dec
+               << ",1,0x" << hex << startPc << "," << image << ",0x" << startPc - 0x400000
+               << dec << ",1,1," << REGION_LENGTH << ",0,0,warmup:" << rid << endl;
+        os << "RegionId = " << rid << "," << tid << "," << rid << ",0x" << hex << startPc << ","
+           << image << ",0x" << startPc - 0x400000 << dec << ",1,0x" << hex << endPc << ","
+           << image << ",0x" << endPc - 0x400000 << dec << ",1,1," << REGION_LENGTH << ","
+           << 1.0 / num << ",1.0,simulation" << endl;
+    }
+}
+
+// The event names of a chain string "event:...,event:...".
+VOID chainEvents(CONTROL_MANAGER& cm, const string& chain, vector<EVENT_TYPE>& events)
+{
+    events.clear();
+    istringstream is(chain);
+    string alarm;
+    while (getline(is, alarm, ','))
+        events.push_back(cm.EventStringToType(alarm.substr(0, alarm.find(':'))));
+}
+
+bool runIregions(const string& fileName, UINT32 warmup, BOOL check, RESULT& r)
+{
+    KNOB_BASE::ClearValues();
+    KNOB_BASE::SetValue("regions:in", fileName);
+    KNOB_BASE::SetValue("regions:warmup", decstr(warmup));
+
+    UINT64 start = nowNs();
+    CONTROL_MANAGER cm;
+    CONTROL_ARGS args("", "pintool:control");
+    CONTROL_IREGIONS* iregions = new CONTROL_IREGIONS(args, &cm);
+    CHAIN_EVENT_VECTOR* chains = NULL;
+    INT32 active               = iregions->Activate(FALSE, &chains);
+    r.setupMs                  = (nowNs() - start) / 1e6;
+    if (!active || !chains || !cm.GetRegionInfoCallback())
+        return false;
+
+    r.chains = chains->size();
+    r.events = 0;
+    r.regions = 0;
+    UINT64 idSum = 0;
+    vector<EVENT_TYPE> events;
+    start = nowNs();
+    for (size_t i = 0; i < chains->size(); i++)
+    {
+        const CHAIN_EVENT& chain = (*chains)[i];
+        chainEvents(cm, chain.chain_str, events);
+        for (size_t e = 0; e < events.size(); e++)
+        {
+            iregions->SetTriggeredRegion(chain.tid, chain.event_handler);
+            if (events[e] == EVENT_START)
+            {
+                CONTROL_REGION_INFO info =
+                    cm.GetRegionInfoCallback()(chain.tid, cm.GetRegionInfoParam());
+                idSum += info.regionId;
+                r.regions++;
+            }
+            r.events++;
+        }
+    }
+    r.nsPerEvent = r.events ? double(nowNs() - start) / r.events : 0;
+    delete iregions;
+    // The synthetic region IDs are 1..n.
+    return !check || idSum == r.regions * (r.regions + 1) / 2;
+}
+
+bool runPcRegions(const string& fileName, BOOL mergeWarmup, RESULT& r)
+{
+    KNOB_BASE::ClearValues();
+    KNOB_BASE::SetValue("pcregions:in", fileName);
+    KNOB_BASE::SetValue("pcregions:merge_warmup", mergeWarmup ? "1" : "0");
+
+    UINT64 start = nowNs();
+    CONTROL_MANAGER cm;
+    CONTROL_ARGS args("", "pintool:control");
+    CONTROL_PCREGIONS* pcregions = new CONTROL_PCREGIONS(args, &cm);
+    BOOL active                  = pcregions->Activate();
+    r.setupMs                    = (nowNs() - start) / 1e6;
+    CHAIN_EVENT_VECTOR* chains   = cm.GetExternalRegionChains();
+    if (!active || !chains || !cm.GetRegionInfoCallback())
+        return false;
+
+    r.chains = chains->size();
+    r.events = 0;
+    r.regions = 0;
+    UINT64 rejected = 0;
+    vector<EVENT_TYPE> events;
+    start = nowNs();
+    for (size_t i = 0; i < chains->size(); i++)
+    {
+        const CHAIN_EVENT& chain = (*chains)[i];
+        chainEvents(cm, chain.chain_str, events);
+        for (size_t e = 0; e < events.size(); e++)
+        {
+            if (!cm.ExternalRegionTriggered(chain.tid, events[e], chain.event_handler))
+                rejected++;
+            else if (events[e] == EVENT_START || events[e] == EVENT_WARMUP_START)
+            {
+                cm.GetRegionInfoCallback()(chain.tid, cm.GetRegionInfoParam());
+                r.regions++;
+            }
+            r.events++;
+        }
+    }
+    r.nsPerEvent = r.events ? double(nowNs() - start) / r.events : 0;
+    delete pcregions;
+    return rejected == 0;
+}
+
+VOID print(const char* controller, const RESULT& r)
+{
+    cout << controller << ',' << r.regions << ',' << r.chains << ',' << fixed
+         << setprecision(2) << r.setupMs << ',' << r.events << ',' << r.nsPerEvent << endl;
+}
+
+VOID usage()
+{
+    cerr << "Usage: bench-regions [-regions <n>] [-threads <n>] [-warmup] [-keep]"
+         << " [-regions-file <file>] [-pcregions-file <file>]" << endl;
+    exit(1);
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    UINT32 num     = 100000;
+    UINT32 threads = 1;
+    BOOL warmup    = FALSE;
+    BOOL keep      = FALSE;
+    string regionsFile, pcRegionsFile;
+
+    for (INT32 i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "-warmup")
+            warmup = TRUE;
+        else if (arg == "-keep")
+            keep = TRUE;
+        else if (i + 1 >= argc)
+            usage();
+        else if (arg == "-regions")
+            num = strtoul(argv[++i], NULL, 0);
+        else if (arg == "-threads")
+            threads = strtoul(argv[++i], NULL, 0);
+        else if (arg == "-regions-file")
+            regionsFile = argv[++i];
+        else if (arg == "-pcregions-file")
+            pcRegionsFile = argv[++i];
+        else
+            usage();
+    }
+    if (num == 0 || threads == 0 || threads > PIN_MAX_THREADS)
+        usage();
+
+    string dir;
+    BOOL synthetic = regionsFile.empty();
+    if (regionsFile.empty() || pcRegionsFile.empty())
+    {
+        char tmpl[] = "/tmp/bench-regions-XXXXXX";
+        if (!mkdtemp(tmpl))
+        {
+            cerr << "Error: cannot create a temporary directory" << endl;
+            return 1;
+        }
+        dir = tmpl;
+        if (regionsFile.empty())
+        {
+            regionsFile = dir + "/regions.csv";
+            writeRegions(regionsFile, num, threads);
+        }
+        if (pcRegionsFile.empty())
+        {
+            pcRegionsFile = dir + "/pcregions.csv";
+            writePcRegions(pcRegionsFile, num, threads, warmup);
+        }
+    }
+
+    cout << "controller,regions,chains,setup ms,events,ns/event" << endl;
+    bool failed = false;
+    RESULT r = RESULT();
+    if (!runIregions(regionsFile, warmup ? REGION_LENGTH / 2 : 0, synthetic, r))
+    {
+        cerr << "Error: CONTROL_IREGIONS check failed" << endl;
+        failed = true;
+    }
+    print("iregions", r);
+    r = RESULT();
+    if (!runPcRegions(pcRegionsFile, warmup, r))
+    {
+        cerr << "Error: CONTROL_PCREGIONS check failed" << endl;
+        failed = true;
+    }
+    print("pcregions", r);
+
+    if (!dir.empty())
+    {
+        if (keep)
+            cerr << "Regions files kept in " << dir << endl;
+        else
+        {
+            unlink((dir + "/regions.csv").c_str());
+            unlink((dir + "/pcregions.csv").c_str());
+            rmdir(dir.c_str());
+        }
+    }
+    return failed ? 1 : 0;
+}
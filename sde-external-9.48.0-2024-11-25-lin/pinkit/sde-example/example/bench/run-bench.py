@@ -0,0 +1,217 @@
+#!/usr/bin/env python3
+# -*- python -*-
+
+# Copyright (C) 2024 Intel Corporation.
+# SPDX-License-Identifier: MIT
+#
+
+# Measure the slowdown of SDE and of the example tools on the benchmark
+# workloads of this directory, relative to the native run of every
+# workload. Every run is repeated and the fastest time is kept. The
+# output of every run must match the output of the native run.
+#
+# The startup of SDE and of the tools (loading, instrumenting the loader
+# and libc, reading a DCFG) does not depend on the workload size, so
+# every command is also timed at scale 0, where the workloads only set
+# up, and the slowdown is the ratio of the times above those. The raw
+# ratio is reported too.
+#
+# Workloads that need CPU features the host lacks (e.g. AVX-512) cannot
+# run natively; SDE without a tool, which emulates them, is their
+# reference instead.
+#
+# The tools that track DCFG loops get a DCFG of the workload made by a
+# first SDE run. Address space randomization is disabled for all runs
+# when setarch is available, so the DCFG addresses stay valid.
+#
+# Usually run with 'make bench' in the example directory.
+
+import argparse
+import csv
+import json
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+# Workload command lines; {objdir} is replaced.
+WORKLOADS = {
+    'pointer-chase': ['{objdir}/bench-pointer-chase.exe'],
+    'stream':        ['{objdir}/bench-stream.exe'],
+    'branchy':       ['{objdir}/bench-branchy.exe'],
+    'barrier':       ['{objdir}/bench-barrier.exe'],
+    'dlopen-storm':  ['{objdir}/bench-dlopen-storm.exe', '{objdir}/bench-dso.so'],
+    'avx512':        ['{objdir}/bench-avx512.exe'],
+}
+
+# CPU flags (of /proc/cpuinfo) needed to run a workload natively.
+WORKLOAD_CPU_FLAGS = {
+    'avx512': ['avx512f'],
+}
+
+# SDE options of the tools; {objdir} and {dcfg} are replaced. 'sde' is
+# SDE without a tool and 'isimpoint' is the SDE built-in BBV profiler.
+TOOLS = {
+    'sde':                [],
+    'isimpoint':          ['-bbprofile', '-slice_size', '1000000'],
+    'looppoint':          ['-t64', '{objdir}/looppoint.so',
+                           '-looppoint:dcfg-file', '{dcfg}'],
+    'loop-profiler':      ['-t64', '{objdir}/loop-profiler.so',
+                           '-loop-profiler:dcfg-file', '{dcfg}'],
+    'loop-tracker':       ['-t64', '{objdir}/loop-tracker.so',
+                           '-loop-tracker:dcfg-file', '{dcfg}'],
+    'controller-example': ['-t64', '{objdir}/controller-example.so',
+                           '-control', 'start:icount:100000,stop:icount:1000000'],
+}
+
+
+def expand(args, **values):
+    return [a.format(**values) for a in args]
+
+
+def run(cmd, cwd):
+    """Run a command, return its time in seconds and its output."""
+    start = time.perf_counter()
+    p = subprocess.run(cmd, cwd=cwd, stdout=subprocess.PIPE,
+                       stderr=subprocess.PIPE, universal_newlines=True)
+    elapsed = time.perf_counter() - start
+    if p.returncode != 0:
+        sys.stderr.write('error: {} exited with {}\n{}'.format(
+            ' '.join(cmd), p.returncode, p.stderr))
+        return None, None
+    return elapsed, p.stdout
+
+
+def cpu_flags():
+    try:
+        with open('/proc/cpuinfo') as f:
+            for line in f:
+                if line.startswith('flags'):
+                    return set(line.split(':', 1)[1].split())
+    except OSError:
+        pass
+    return set()
+
+
+def best_of(cmd, cwd, repeat):
+    best, output = None, None
+    for _ in range(repeat):
+        elapsed, out = run(cmd, cwd)
+        if elapsed is None:
+            return None, None
+        if best is None or elapsed < best:
+            best = elapsed
+        output = out
+    return best, output
+
+
+def main():
+    parser = argparse.ArgumentParser(description='SDE tool overhead benchmarks')
+    parser.add_argument('--sde', required=True, help='path of sde64')
+    parser.add_argument('--objdir', required=True,
+                        help='directory of the workloads and the tools')
+    parser.add_argument('--workloads', default=' '.join(WORKLOADS),
+                        help='space separated workloads')
+    parser.add_argument('--tools', default=' '.join(TOOLS),
+                        help='space separated tools')
+    parser.add_argument('--scale', type=int, default=10,
+                        help='workload size multiplier')
+    parser.add_argument('--repeat', type=int, default=3,
+                        help='runs per measurement, the fastest is kept')
+    parser.add_argument('--out', default='bench-results.csv',
+                        help='CSV output file')
+    parser.add_argument('--json', help='optional JSON output file')
+    args = parser.parse_args()
+
+    sde = os.path.abspath(args.sde)
+    objdir = os.path.abspath(args.objdir)
+    prefix = []
+    if shutil.which('setarch'):
+        prefix = ['setarch', os.uname().machine, '-R']
+
+    results = []
+    failed = False
+    host_flags = cpu_flags()
+    for name in args.workloads.split():
+        if name not in WORKLOADS:
+            sys.exit('error: unknown workload ' + name)
+        app = expand(WORKLOADS[name], objdir=objdir)
+        workdir = tempfile.mkdtemp(prefix='bench-' + name + '-')
+
+        def measure(cmd):
+            """Time cmd at the scale and at scale 0, return the times and
+            the output at the scale."""
+            elapsed, output = best_of(prefix + cmd + [str(args.scale)], workdir,
+                                      args.repeat)
+            if elapsed is None:
+                return None, None, None
+            startup, _ = best_of(prefix + cmd + ['0'], workdir, args.repeat)
+            if startup is None:
+                return None, None, None
+            return elapsed, startup, output
+
+        native = all(f in host_flags for f in WORKLOAD_CPU_FLAGS.get(name, []))
+        reference = 'native' if native else 'sde'
+        ref_cmd = app if native else [sde, '--'] + app
+        ref, ref_startup, expected = measure(ref_cmd)
+        if ref is None:
+            failed = True
+            continue
+        # At least a millisecond, the times are only that precise.
+        ref_work = max(ref - ref_startup, 0.001)
+
+        dcfg = None
+        for tool in args.tools.split():
+            if tool not in TOOLS:
+                sys.exit('error: unknown tool ' + tool)
+            if '{dcfg}' in ' '.join(TOOLS[tool]) and dcfg is None:
+                base = os.path.join(workdir, 'bench')
+                cmd = [sde, '-dcfg', '-dcfg:out_base_name', base, '--'] + app + \
+                      [str(args.scale)]
+                if run(prefix + cmd, workdir)[0] is None:
+                    failed = True
+                    continue
+                dcfg = base + '.dcfg.json.bz2'
+            cmd = [sde] + expand(TOOLS[tool], objdir=objdir, dcfg=dcfg or '') + ['--'] + app
+            elapsed, startup, output = measure(cmd)
+            if elapsed is None:
+                failed = True
+                continue
+            result = {
+                'workload': name,
+                'tool': tool,
+                'scale': args.scale,
+                'reference': reference,
+                'reference_seconds': round(ref, 4),
+                'reference_startup_seconds': round(ref_startup, 4),
+                'seconds': round(elapsed, 4),
+                'startup_seconds': round(startup, 4),
+                'raw_slowdown': round(elapsed / ref, 2),
+                'slowdown': round(max(elapsed - startup, 0.001) / ref_work, 2),
+                'output_ok': output == expected,
+            }
+            failed |= not result['output_ok']
+            results.append(result)
+            print('{workload:14} {tool:20} {seconds:9.3f}s {startup_seconds:7.3f}s '
+                  '{slowdown:8.2f}x {raw_slowdown:8.2f}x raw'.format(**result) +
+                  ('' if native else ' (vs sde)') +
+                  ('' if result['output_ok'] else '  OUTPUT MISMATCH'))
+        shutil.rmtree(workdir, ignore_errors=True)
+
+    fields = ['workload', 'tool', 'scale', 'reference', 'reference_seconds',
+              'reference_startup_seconds', 'seconds', 'startup_seconds',
+              'raw_slowdown', 'slowdown', 'output_ok']
+    with open(args.out, 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=fields)
+        writer.writeheader()
+        writer.writerows(results)
+    if args.json:
+        with open(args.json, 'w') as f:
+            json.dump(results, f, indent=1)
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2024 Intel Corporation.
+ * SPDX-License-Identifier: MIT
+ */
+
+// Benchmark workload: STREAM-like copy, scale, add and triad kernels.
+//   bench-stream [<scale>]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char* argv[])
+{
+    unsigned scale = argc > 1 ? atoi(argv[1]) : 1;
+    size_t n       = 1 << 21;
+    double* a      = malloc(n * sizeof(double));
+    double* b      = malloc(n * sizeof(double));
+    double* c      = malloc(n * sizeof(double));
+    if (!a || !b || !c)
+        return 1;
+    for (size_t i = 0; i < n; i++)
+    {
+        a[i] = 1.0;
+        b[i] = 2.0;
+        c[i] = 0.0;
+    }
+
+    for (unsigned rep = 0; rep < scale * 4; rep++)
+    {
+        for (size_t i = 0; i < n; i++)
+            c[i] = a[i];
+        for (size_t i = 0; i < n; i++)
+            b[i] = 3.0 * c[i];
+        for (size_t i = 0; i < n; i++)
+            c[i] = a[i] + b[i];
+        for (size_t i = 0; i < n; i++)
+            a[i] = b[i] + 3.0 * c[i];
+    }
+
+    double sum = 0;
+    for (size_t i = 0; i < n; i++)
+        sum += a[i] + b[i] + c[i];
+    printf("checksum %.17g\n", sum);
+    free(a);
+    free(b);
+    free(c);
+    return 0;
+}
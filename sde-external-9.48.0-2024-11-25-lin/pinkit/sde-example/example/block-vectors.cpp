@@ -0,0 +1,30 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that writes basic block vectors with block
+  IDs that stay bounded for JIT compiled and self modifying code, e.g.:
+    sde64 -t block-vectors.so -block-vectors:slice-size 100000000 -- <application>
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "block-vectors.H"
+
+block_vectors::BLOCK_VECTORS blockVectors;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate the block vectors.
+    blockVectors.activate();
+
+    PIN_StartProgram(); // Never returns
+    return 0;
+}
@@ -0,0 +1,30 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that checks the call/return
+  correlation of every thread against a shadow stack, as done by
+  the CET stack checks.
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "cet-shadow-stack.H"
+
+cet_shadow_stack::CET_SHADOW_STACK cetShadowStack;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate the shadow-stack checks.
+    cetShadowStack.activate();
+
+    PIN_StartProgram(); // Never returns
+    return 0;
+}
@@ -0,0 +1,30 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that checks on which chips the executed
+  instructions are legal, for all the chips in one run, e.g.:
+    sde64 -t chip-legality.so -chip-legality:chips SKYLAKE,ICE_LAKE -- <application>
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "chip-legality.H"
+
+chip_legality::CHIP_LEGALITY chipLegality;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate the chip legality analysis.
+    chipLegality.activate();
+
+    PIN_StartProgram(); // Never returns
+    return 0;
+}
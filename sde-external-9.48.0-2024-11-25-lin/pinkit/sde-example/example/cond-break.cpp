@@ -0,0 +1,32 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool with conditional breakpoints evaluated in
+  the analysis routines, for application debugging, e.g.:
+    sde64 -appdebug -t cond-break.so -- <application>
+  and at the debugger prompt:
+    monitor cond-break 0x401136 if $rdi == 7 && hits > 1000
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "cond-break.H"
+
+cond_break::COND_BREAK condBreak;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate the conditional breakpoints.
+    condBreak.activate();
+
+    PIN_StartProgram(); // Never returns
+    return 0;
+}
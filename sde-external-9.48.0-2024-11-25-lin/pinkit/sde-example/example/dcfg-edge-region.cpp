@@ -0,0 +1,161 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+// Program to extract the edges of a region of an indexed DCFG edge trace
+// written by the dcfg-edge-trace tool.
+//
+// The region starts at the block containing the given instruction of the
+// thread and ends with the block containing the last instruction of the
+// region. The reader seeks to the closest checkpoint of the index, so only
+// the edges after it are decoded.
+
+#include "dcfg_api.H"
+#include "dcfg-edge-trace-reader.H"
+
+#include <stdlib.h>
+#include <assert.h>
+#include <iostream>
+#include <string>
+
+using namespace std;
+using namespace dcfg_api;
+using namespace dcfg_edge_trace;
+
+char* dcfg_file   = NULL;
+char* trace_base  = NULL;
+UINT32 thread_id  = 0;
+UINT64 start      = 0;
+UINT64 num_instrs = 0; // 0 for the rest of the trace
+bool by_edge      = false;
+
+// Print usage and exit.
+void usage(const char* cmd)
+{
+    cerr << "This program inputs a DCFG file in JSON format and an indexed edge trace"
+            " written by the dcfg-edge-trace tool,"
+         << endl
+         << "and outputs the sequence of edges of a region of one thread." << endl
+         << "With -edges, the region starts at an edge offset and its length is a number "
+            "of edges."
+         << endl
+         << "Usage:" << endl
+         << cmd
+         << " [ -tid <thread-id> -edges ] <dcfg-file> <trace-base-name> <start-icount>"
+            " [<num-instrs>]"
+         << endl;
+    exit(1);
+}
+
+void parse_args(int argc, char* argv[])
+{
+    int pos = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        string arg = argv[i];
+        if (arg == "-tid")
+        {
+            if (i + 1 == argc)
+                usage(argv[0]);
+            thread_id = strtoul(argv[++i], NULL, 0);
+        }
+        else if (arg == "-edges")
+            by_edge = true;
+        else if (pos == 0)
+            dcfg_file = argv[i], pos++;
+        else if (pos == 1)
+            trace_base = argv[i], pos++;
+        else if (pos == 2)
+            start = strtoull(argv[i], NULL, 0), pos++;
+        else if (pos == 3)
+            num_instrs = strtoull(argv[i], NULL, 0), pos++;
+        else
+        {
+            cerr << "Unused argument " << argv[i] << endl;
+            usage(argv[0]);
+        }
+    }
+    if (pos < 3)
+        usage(argv[0]);
+}
+
+int main(int argc, char* argv[])
+{
+    parse_args(argc, argv);
+
+    DCFG_DATA* dcfg = DCFG_DATA::new_dcfg();
+    cerr << "Reading DCFG from '" << dcfg_file << "'..." << endl;
+    string errMsg;
+    if (!dcfg->read(dcfg_file, errMsg))
+    {
+        cerr << "error: " << errMsg << endl;
+        delete dcfg;
+        return 1;
+    }
+    DCFG_ID_VECTOR proc_ids;
+    dcfg->get_process_ids(proc_ids);
+    if (proc_ids.size() != 1)
+    {
+        cerr << "error: DCFG contains " << proc_ids.size() << " processes; expected one."
+             << endl;
+        delete dcfg;
+        return 1;
+    }
+    DCFG_PROCESS_CPTR pinfo = dcfg->get_process_info(proc_ids[0]);
+    assert(pinfo);
+
+    DCFG_EDGE_TRACE_READER reader(pinfo);
+    bool ok = reader.open(trace_base, thread_id, errMsg) &&
+        (by_edge ? reader.seek_to_edge(start, errMsg) : reader.seek_to_icount(start, errMsg));
+    if (!ok)
+    {
+        cerr << "error: " << errMsg << endl;
+        delete dcfg;
+        return 1;
+    }
+    cerr << "Region starts at edge " << reader.get_edge_offset() << " of "
+         << reader.get_num_edges() << ", instruction " << reader.get_icount() << " of "
+         << reader.get_num_instrs() << "." << endl;
+
+    UINT64 end = num_instrs ? start + num_instrs : 0;
+    cout << "edge offset,icount,edge id,basic-block id,basic-block addr,basic-block "
+            "symbol,num instrs in BB"
+         << endl;
+    bool done = false;
+    DCFG_ID_VECTOR edge_ids;
+    while (!done)
+    {
+        UINT64 edgeOffset = reader.get_edge_offset();
+        UINT64 icount     = reader.get_icount();
+        edge_ids.clear();
+        if (!reader.get_edge_ids(edge_ids, done, errMsg))
+        {
+            cerr << "error: " << errMsg << endl;
+            done = true;
+        }
+        for (size_t j = 0; j < edge_ids.size(); j++, edgeOffset++)
+        {
+            if (end && (by_edge ? edgeOffset : icount) >= end)
+            {
+                done = true;
+                break;
+            }
+            DCFG_EDGE_CPTR edge      = pinfo->get_edge_info(edge_ids[j]);
+            DCFG_BASIC_BLOCK_CPTR bb = edge ? pinfo->get_basic_block_info(
+                                                  edge->get_target_node_id())
+                                            : NULL;
+            if (!bb)
+                continue;
+            const string* symbol = bb->get_symbol_name();
+            cout << edgeOffset << ',' << icount << ',' << edge_ids[j] << ','
+                 << bb->get_basic_block_id() << ',' << (void*)bb->get_first_instr_addr() << ','
+                 << '"' << (symbol ? *symbol : "unknown") << '"' << ',' << bb->get_num_instrs()
+                 << endl;
+            icount += bb->get_num_instrs();
+        }
+    }
+
+    delete dcfg;
+    return 0;
+}
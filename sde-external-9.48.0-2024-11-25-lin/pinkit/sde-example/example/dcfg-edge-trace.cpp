@@ -0,0 +1,43 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that writes the sequence of the edges of an
+  input Dynamic Control Flow Graph (DCFG) with an index for random access,
+  e.g.:
+    sde64 -t dcfg-edge-trace.so -dcfg-edge-trace:dcfg-file <name>.dcfg.json.bz2
+          -- <application>
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "dcfg_pin_api.H"
+#include "dcfg-edge-trace.H"
+
+using namespace dcfg_pin_api;
+
+dcfg_edge_trace::DCFG_EDGE_TRACE edgeTrace;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate DCFG generation if enabling knob was used.
+    DCFG_PIN_MANAGER* dcfgMgr = DCFG_PIN_MANAGER::new_manager();
+    if (dcfgMgr->dcfg_enable_knob())
+    {
+        dcfgMgr->activate();
+    }
+
+    // Activate the edge trace.
+    edgeTrace.activate();
+
+    PIN_StartProgram(); // Never returns
+    delete dcfgMgr;
+    return 0;
+}
@@ -0,0 +1,698 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+// Program to recompute the dominators and the loop nests of a DCFG offline.
+//
+// Only the basic blocks, their routine, the edges and the counts are used
+// from the DCFG. For every routine, the graph of the edges inside the
+// routine is searched depth first from the entry node and the immediate
+// dominators are computed with the iterative algorithm of Cooper, Harvey
+// and Kennedy. Calls and returns are left out, except those of a routine
+// that calls itself, which the collector keeps as well. An edge whose
+// target dominates its source is a back edge, and the natural loop of a
+// head node is the union of the nodes that reach one of its back edges
+// without passing the head. A retreating edge of the depth-first search
+// that is not a back edge enters an irreducible region; those regions have
+// no natural loop.
+//
+// The routines are analyzed in parallel by forked worker processes, which
+// share the DCFG read by the parent and send their results through pipes.
+// With -verify, the results are compared with the dominators and loops
+// stored in the DCFG.
+
+#include "dcfg_api.H"
+#include "sde-dcfg-edges.H"
+
+#include <stdlib.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+using namespace std;
+using namespace dcfg_api;
+
+char* dcfg_file    = NULL;
+char* out_file     = NULL;
+UINT32 num_jobs    = 4;
+bool print_idoms   = false;
+bool verify_loops  = false;
+
+// Edge inside a routine, between local node indices.
+struct LocalEdge
+{
+    UINT32 source;
+    UINT32 target;
+    UINT64 count;
+};
+
+// A natural loop found in a routine.
+struct Loop
+{
+    UINT32 head;
+    vector<UINT32> nodes;
+    UINT32 numBackEdges;
+    UINT64 backEdgeCount;
+    INT32 parent; // index in the loop vector or -1
+    UINT32 depth;
+};
+
+// Dominator and loop analysis of one routine.
+class RoutineAnalysis
+{
+  public:
+    DCFG_PROCESS_CPTR pinfo;
+    DCFG_ROUTINE_CPTR rinfo;
+    vector<DCFG_ID> ids;           // local index to DCFG ID
+    map<DCFG_ID, UINT32> index;    // DCFG ID to local index
+    vector<LocalEdge> edges;
+    vector<vector<UINT32> > succs; // edge indices by source
+    vector<vector<UINT32> > preds; // edge indices by target
+    vector<INT32> rpoNumber;       // -1 if unreachable from the entry
+    vector<UINT32> rpo;
+    vector<INT32> idom;
+    vector<Loop> loops;
+    UINT32 numIrreducibleEdges;
+
+    RoutineAnalysis(DCFG_PROCESS_CPTR p, DCFG_ROUTINE_CPTR r)
+        : pinfo(p), rinfo(r), numIrreducibleEdges(0)
+    {
+    }
+
+    // Build the local graph. The entry node is local node 0.
+    void build(const vector<DCFG_ID>& blocks, const vector<DCFG_EDGE_CPTR>& routineEdges)
+    {
+        addNode(rinfo->get_routine_id());
+        for (size_t i = 0; i < blocks.size(); i++)
+            addNode(blocks[i]);
+        succs.resize(ids.size());
+        preds.resize(ids.size());
+        for (size_t i = 0; i < routineEdges.size(); i++)
+        {
+            LocalEdge e;
+            e.source = index[routineEdges[i]->get_source_node_id()];
+            e.target = index[routineEdges[i]->get_target_node_id()];
+            e.count  = routineEdges[i]->get_exec_count();
+            succs[e.source].push_back(edges.size());
+            preds[e.target].push_back(edges.size());
+            edges.push_back(e);
+        }
+    }
+
+    void analyze()
+    {
+        depthFirstSearch();
+        computeDominators();
+        findLoops();
+    }
+
+    bool dominates(UINT32 a, UINT32 b) const
+    {
+        if (rpoNumber[b] < 0)
+            return false;
+        while (b != a && b != 0)
+            b = idom[b];
+        return b == a;
+    }
+
+  private:
+    void addNode(DCFG_ID id)
+    {
+        if (index.count(id))
+            return;
+        index[id] = ids.size();
+        ids.push_back(id);
+    }
+
+    // Number the nodes in reverse postorder and count the retreating
+    // edges that are not back edges after the dominators are known.
+    void depthFirstSearch()
+    {
+        UINT32 n = ids.size();
+        rpoNumber.assign(n, -1);
+        vector<UINT32> post;
+        vector<bool> visited(n, false);
+        vector<pair<UINT32, UINT32> > stack; // node, next successor
+        stack.push_back(make_pair(0, 0));
+        visited[0] = true;
+        while (!stack.empty())
+        {
+            UINT32 node = stack.back().first;
+            UINT32& next = stack.back().second;
+            if (next < succs[node].size())
+            {
+                UINT32 target = edges[succs[node][next++]].target;
+                if (!visited[target])
+                {
+                    visited[target] = true;
+                    stack.push_back(make_pair(target, 0));
+                }
+                continue;
+            }
+            post.push_back(node);
+            stack.pop_back();
+        }
+        rpo.assign(post.rbegin(), post.rend());
+        for (UINT32 i = 0; i < rpo.size(); i++)
+            rpoNumber[rpo[i]] = i;
+    }
+
+    UINT32 intersect(UINT32 a, UINT32 b) const
+    {
+        while (a != b)
+        {
+            while (rpoNumber[a] > rpoNumber[b])
+                a = idom[a];
+            while (rpoNumber[b] > rpoNumber[a])
+                b = idom[b];
+        }
+        return a;
+    }
+
+    // Cooper, Harvey and Kennedy, "A Simple, Fast Dominance Algorithm".
+    void computeDominators()
+    {
+        idom.assign(ids.size(), -1);
+        idom[0]      = 0;
+        bool changed = true;
+        while (changed)
+        {
+            changed = false;
+            for (UINT32 i = 1; i < rpo.size(); i++)
+            {
+                UINT32 node  = rpo[i];
+                INT32 newIdom = -1;
+                for (size_t p = 0; p < preds[node].size(); p++)
+                {
+                    UINT32 pred = edges[preds[node][p]].source;
+                    if (idom[pred] < 0)
+                        continue;
+                    newIdom = newIdom < 0 ? INT32(pred) : INT32(intersect(pred, newIdom));
+                }
+                if (newIdom != idom[node])
+                {
+                    idom[node] = newIdom;
+                    changed    = true;
+                }
+            }
+        }
+    }
+
+    void findLoops()
+    {
+        map<UINT32, UINT32> loopOfHead;
+        for (UINT32 ei = 0; ei < edges.size(); ei++)
+        {
+            const LocalEdge& e = edges[ei];
+            if (rpoNumber[e.source] < 0 || rpoNumber[e.target] > rpoNumber[e.source])
+                continue;
+            if (!dominates(e.target, e.source))
+            {
+                numIrreducibleEdges++;
+                continue;
+            }
+            if (!loopOfHead.count(e.target))
+            {
+                Loop loop;
+                loop.head          = e.target;
+                loop.numBackEdges  = 0;
+                loop.backEdgeCount = 0;
+                loop.parent        = -1;
+                loop.depth         = 1;
+                loopOfHead[e.target] = loops.size();
+                loops.push_back(loop);
+            }
+            Loop& loop = loops[loopOfHead[e.target]];
+            loop.numBackEdges++;
+            loop.backEdgeCount += e.count;
+        }
+
+        // Natural loop bodies: walk the predecessors from the back edge
+        // sources up to the head.
+        for (size_t li = 0; li < loops.size(); li++)
+        {
+            Loop& loop = loops[li];
+            vector<bool> inLoop(ids.size(), false);
+            vector<UINT32> work;
+            inLoop[loop.head] = true;
+            for (size_t p = 0; p < preds[loop.head].size(); p++)
+            {
+                UINT32 source = edges[preds[loop.head][p]].source;
+                if (dominates(loop.head, source) && !inLoop[source])
+                {
+                    inLoop[source] = true;
+                    work.push_back(source);
+                }
+            }
+            while (!work.empty())
+            {
+                UINT32 node = work.back();
+                work.pop_back();
+                for (size_t p = 0; p < preds[node].size(); p++)
+                {
+                    UINT32 source = edges[preds[node][p]].source;
+                    if (rpoNumber[source] >= 0 && !inLoop[source])
+                    {
+                        inLoop[source] = true;
+                        work.push_back(source);
+                    }
+                }
+            }
+            for (UINT32 n = 0; n < ids.size(); n++)
+                if (inLoop[n])
+                    loop.nodes.push_back(n);
+        }
+
+        // The parent of a loop is the smallest other loop containing its
+        // head; natural loops with different heads are nested or disjoint.
+        for (size_t li = 0; li < loops.size(); li++)
+        {
+            for (size_t pi = 0; pi < loops.size(); pi++)
+            {
+                if (pi == li || !binary_search(loops[pi].nodes.begin(), loops[pi].nodes.end(),
+                                               loops[li].head))
+                    continue;
+                if (loops[li].parent < 0 ||
+                    loops[pi].nodes.size() < loops[loops[li].parent].nodes.size())
+                    loops[li].parent = pi;
+            }
+        }
+        for (size_t li = 0; li < loops.size(); li++)
+            for (INT32 p = loops[li].parent; p >= 0; p = loops[p].parent)
+                loops[li].depth++;
+    }
+};
+
+// Results of one routine.
+struct RoutineResult
+{
+    string routines;
+    string loops;
+    string idoms;
+    UINT32 numMismatches;
+
+    RoutineResult() : numMismatches(0) {}
+};
+
+string symbolOf(DCFG_PROCESS_CPTR pinfo, DCFG_ID id)
+{
+    DCFG_BASIC_BLOCK_CPTR bb = pinfo->get_basic_block_info(id);
+    const string* symbol     = bb ? bb->get_symbol_name() : NULL;
+    return symbol ? *symbol : string("unknown");
+}
+
+UINT64 execCountOf(DCFG_PROCESS_CPTR pinfo, DCFG_ID id)
+{
+    DCFG_BASIC_BLOCK_CPTR bb = pinfo->get_basic_block_info(id);
+    return bb ? bb->get_exec_count() : 0;
+}
+
+// Compare the analysis with the dominators and loops stored in the DCFG,
+// print the differences on stderr and return their number.
+UINT32 verify(const RoutineAnalysis& ra)
+{
+    UINT32 numMismatches = 0;
+    DCFG_ID rid          = ra.rinfo->get_routine_id();
+    for (UINT32 n = 1; n < ra.ids.size(); n++)
+    {
+        DCFG_ID computed = ra.idom[n] < 0 ? 0 : ra.ids[ra.idom[n]];
+        DCFG_ID stored   = ra.rinfo->get_idom_node_id(ra.ids[n]);
+        if (computed != stored)
+        {
+            cerr << "Mismatch: routine " << rid << " node " << ra.ids[n] << " idom "
+                 << computed << ", DCFG idom " << stored << endl;
+            numMismatches++;
+        }
+    }
+
+    DCFG_ID_SET storedLoops;
+    ra.rinfo->get_loop_ids(storedLoops);
+    for (size_t li = 0; li < ra.loops.size(); li++)
+    {
+        const Loop& loop = ra.loops[li];
+        DCFG_ID head     = ra.ids[loop.head];
+        DCFG_ID parent   = loop.parent < 0 ? 0 : ra.ids[ra.loops[loop.parent].head];
+        DCFG_LOOP_CPTR linfo = ra.pinfo->get_loop_info(head);
+        if (!storedLoops.erase(head) || !linfo)
+        {
+            cerr << "Mismatch: routine " << rid << " loop " << head << " not in DCFG" << endl;
+            numMismatches++;
+            continue;
+        }
+        DCFG_ID_SET nodes, backEdges;
+        linfo->get_basic_block_ids(nodes);
+        linfo->get_back_edge_ids(backEdges);
+        if (linfo->get_parent_loop_id() != parent || nodes.size() != loop.nodes.size() ||
+            backEdges.size() != loop.numBackEdges)
+        {
+            cerr << "Mismatch: routine " << rid << " loop " << head << " parent " << parent
+                 << " nodes " << loop.nodes.size() << " back edges " << loop.numBackEdges
+                 << ", DCFG parent " << linfo->get_parent_loop_id() << " nodes "
+                 << nodes.size() << " back edges " << backEdges.size() << endl;
+            numMismatches++;
+        }
+    }
+    for (DCFG_ID_SET::iterator it = storedLoops.begin(); it != storedLoops.end(); it++)
+    {
+        cerr << "Mismatch: routine " << rid << " DCFG loop " << *it << " not found" << endl;
+        numMismatches++;
+    }
+    return numMismatches;
+}
+
+RoutineResult analyzeRoutine(DCFG_PROCESS_CPTR pinfo, DCFG_ROUTINE_CPTR rinfo,
+                             const vector<DCFG_ID>& blocks,
+                             const vector<DCFG_EDGE_CPTR>& routineEdges)
+{
+    RoutineAnalysis ra(pinfo, rinfo);
+    ra.build(blocks, routineEdges);
+    ra.analyze();
+
+    RoutineResult result;
+    DCFG_ID rid = rinfo->get_routine_id();
+    ostringstream ros, los, ios;
+    ros << pinfo->get_process_id() << ',' << rid << ",\"" << symbolOf(pinfo, rid) << "\","
+        << ra.ids.size() << ',' << ra.edges.size() << ',' << ra.loops.size() << ','
+        << ra.numIrreducibleEdges << ',' << rinfo->get_entry_count() << endl;
+
+    for (size_t li = 0; li < ra.loops.size(); li++)
+    {
+        const Loop& loop = ra.loops[li];
+        DCFG_ID head     = ra.ids[loop.head];
+        UINT64 iterations = execCountOf(pinfo, head);
+        los << pinfo->get_process_id() << ',' << head << ','
+            << (loop.parent < 0 ? 0 : ra.ids[ra.loops[loop.parent].head]) << ',' << rid
+            << ",\"" << symbolOf(pinfo, head) << "\"," << loop.depth << ','
+            << loop.nodes.size() << ',' << loop.numBackEdges << ','
+            << iterations - loop.backEdgeCount << ',' << iterations << endl;
+    }
+
+    if (print_idoms)
+        for (UINT32 n = 1; n < ra.ids.size(); n++)
+            ios << pinfo->get_process_id() << ',' << ra.ids[n] << ','
+                << (ra.idom[n] < 0 ? 0 : ra.ids[ra.idom[n]]) << ',' << rid << endl;
+
+    if (verify_loops)
+        result.numMismatches = verify(ra);
+    result.routines = ros.str();
+    result.loops    = los.str();
+    result.idoms    = ios.str();
+    return result;
+}
+
+// Routines of all processes with their blocks and internal edges.
+struct RoutineWork
+{
+    DCFG_PROCESS_CPTR pinfo;
+    DCFG_ROUTINE_CPTR rinfo;
+    vector<DCFG_ID> blocks;
+    vector<DCFG_EDGE_CPTR> edges;
+};
+
+void collectRoutines(DCFG_DATA_CPTR dcfg, vector<RoutineWork>& work)
+{
+    DCFG_ID_VECTOR proc_ids;
+    dcfg->get_process_ids(proc_ids);
+    for (size_t pi = 0; pi < proc_ids.size(); pi++)
+    {
+        DCFG_PROCESS_CPTR pinfo = dcfg->get_process_info(proc_ids[pi]);
+        assert(pinfo);
+
+        // Routine of every block, from the block data only.
+        map<DCFG_ID, size_t> routineIndex;
+        DCFG_ID_VECTOR bb_ids;
+        pinfo->get_basic_block_ids(bb_ids);
+        map<DCFG_ID, DCFG_ID> routineOf;
+        for (size_t bi = 0; bi < bb_ids.size(); bi++)
+        {
+            if (pinfo->is_special_node(bb_ids[bi]))
+                continue;
+            DCFG_BASIC_BLOCK_CPTR bb = pinfo->get_basic_block_info(bb_ids[bi]);
+            assert(bb);
+            DCFG_ID rid = bb->get_routine_id();
+            if (!rid)
+                continue;
+            if (!routineIndex.count(rid))
+            {
+                DCFG_IMAGE_CPTR iinfo = pinfo->get_image_info(bb->get_image_id());
+                DCFG_ROUTINE_CPTR rinfo = iinfo ? iinfo->get_routine_info(rid) : NULL;
+                if (!rinfo)
+                    continue;
+                routineIndex[rid] = work.size();
+                work.push_back(RoutineWork());
+                work.back().pinfo = pinfo;
+                work.back().rinfo = rinfo;
+            }
+            routineOf[bb_ids[bi]] = rid;
+            work[routineIndex[rid]].blocks.push_back(bb_ids[bi]);
+        }
+
+        // Edges inside a routine. Like the collector, this keeps the calls
+        // and returns of a routine that calls itself: the call is a back
+        // edge to the entry and the return enters the block after the call.
+        DCFG_ID_VECTOR edge_ids;
+        INSTLIB::get_all_edge_ids(pinfo, edge_ids);
+        for (size_t ei = 0; ei < edge_ids.size(); ei++)
+        {
+            DCFG_EDGE_CPTR edge = pinfo->get_edge_info(edge_ids[ei]);
+            if (!edge)
+                continue;
+            map<DCFG_ID, DCFG_ID>::iterator src = routineOf.find(edge->get_source_node_id());
+            map<DCFG_ID, DCFG_ID>::iterator dst = routineOf.find(edge->get_target_node_id());
+            if (src == routineOf.end() || dst == routineOf.end() || src->second != dst->second)
+                continue;
+            work[routineIndex[src->second]].edges.push_back(edge);
+        }
+    }
+}
+
+////// Parallel analysis.
+
+bool writeAll(int fd, const string& data)
+{
+    size_t done = 0;
+    while (done < data.size())
+    {
+        ssize_t n = write(fd, data.data() + done, data.size() - done);
+        if (n <= 0)
+            return false;
+        done += n;
+    }
+    return true;
+}
+
+string readAll(int fd)
+{
+    string data;
+    char buf[64 * 1024];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0)
+        data.append(buf, n);
+    return data;
+}
+
+// Serialize the results as "<routine> <mismatches> <len> <len> <len>\n"
+// followed by the three strings.
+void saveResult(ostream& os, size_t ri, const RoutineResult& r)
+{
+    os << ri << ' ' << r.numMismatches << ' ' << r.routines.size() << ' ' << r.loops.size()
+       << ' ' << r.idoms.size() << '\n'
+       << r.routines << r.loops << r.idoms;
+}
+
+bool loadResults(istream& is, vector<RoutineResult>& results)
+{
+    size_t ri, len[3];
+    UINT32 numMismatches;
+    while (is >> ri >> numMismatches >> len[0] >> len[1] >> len[2])
+    {
+        if (ri >= results.size() || is.get() != '\n')
+            return false;
+        RoutineResult& r = results[ri];
+        r.numMismatches  = numMismatches;
+        string* fields[] = {&r.routines, &r.loops, &r.idoms};
+        for (int f = 0; f < 3; f++)
+        {
+            fields[f]->resize(len[f]);
+            if (len[f] && !is.read(&(*fields[f])[0], len[f]))
+                return false;
+        }
+    }
+    return is.eof();
+}
+
+void analyzeAll(const vector<RoutineWork>& work, vector<RoutineResult>& results)
+{
+    results.resize(work.size());
+    UINT32 numWorkers = min<UINT32>(num_jobs, work.size());
+    if (numWorkers <= 1)
+    {
+        for (size_t ri = 0; ri < work.size(); ri++)
+            results[ri] =
+                analyzeRoutine(work[ri].pinfo, work[ri].rinfo, work[ri].blocks, work[ri].edges);
+        return;
+    }
+
+    vector<int> fds(numWorkers);
+    vector<pid_t> pids(numWorkers);
+    for (UINT32 i = 0; i < numWorkers; i++)
+    {
+        int p[2];
+        if (pipe(p) != 0 || (pids[i] = fork()) < 0)
+        {
+            cerr << "error: cannot create worker process" << endl;
+            exit(1);
+        }
+        if (pids[i] == 0)
+        {
+            // Worker process: analyze every numWorkers-th routine.
+            close(p[0]);
+            ostringstream os;
+            for (size_t ri = i; ri < work.size(); ri += numWorkers)
+                saveResult(os, ri,
+                           analyzeRoutine(work[ri].pinfo, work[ri].rinfo, work[ri].blocks,
+                                          work[ri].edges));
+            bool ok = writeAll(p[1], os.str());
+            close(p[1]);
+            _exit(ok ? 0 : 1);
+        }
+        close(p[1]);
+        fds[i] = p[0];
+    }
+
+    for (UINT32 i = 0; i < numWorkers; i++)
+    {
+        istringstream is(readAll(fds[i]));
+        close(fds[i]);
+        int status = 0;
+        waitpid(pids[i], &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !loadResults(is, results))
+        {
+            cerr << "error: worker process " << i << " failed" << endl;
+            exit(1);
+        }
+    }
+}
+
+// Print usage and exit.
+void usage(const char* cmd)
+{
+    cerr << "This program recomputes the immediate dominators, natural loops, loop nesting"
+         << endl
+         << "and irreducible edges of every routine of a DCFG file in JSON format." << endl
+         << "Usage:" << endl
+         << cmd << " [ -o <out-file> ] [ -j <num-processes> ] [ -idoms ] [ -verify ] <dcfg-file>"
+         << endl;
+    exit(1);
+}
+
+void parse_args(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++) // skip argv[0], the program name
+    {
+        string arg(argv[i]);
+        if (arg == "-o" || arg == "-j")
+        {
+            if ((i + 1) == argc)
+            {
+                cerr << "Must provide a value after '" << arg << "'." << endl;
+                usage(argv[0]);
+            }
+            i++;
+            if (arg == "-o")
+                out_file = argv[i];
+            else
+                num_jobs = atoi(argv[i]);
+        }
+        else if (arg == "-idoms")
+            print_idoms = true;
+        else if (arg == "-verify")
+            verify_loops = true;
+        else if (arg[0] == '-' || dcfg_file)
+        {
+            cerr << "Unknown option " << arg << endl;
+            usage(argv[0]);
+        }
+        else
+            dcfg_file = argv[i];
+    }
+    if (num_jobs == 0)
+        num_jobs = 1;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+        usage(argv[0]);
+
+    parse_args(argc, argv);
+
+    if (!dcfg_file)
+    {
+        cerr << "Missing dcfg file. " << endl;
+        usage(argv[0]);
+    }
+
+    ofstream fos;
+    if (out_file)
+    {
+        fos.open(out_file, ios_base::out);
+        if (!fos.is_open())
+        {
+            cerr << "Error: cannot open '" << out_file << "' for writing." << endl;
+            return 1;
+        }
+    }
+    ostream& os = out_file ? fos : cout;
+
+    DCFG_DATA* dcfg = DCFG_DATA::new_dcfg();
+    string errMsg;
+    if (!dcfg->read(dcfg_file, errMsg))
+    {
+        cerr << "error: '" << errMsg << "'" << endl;
+        return 1;
+    }
+
+    vector<RoutineWork> work;
+    collectRoutines(dcfg, work);
+    vector<RoutineResult> results;
+    analyzeAll(work, results);
+
+    UINT32 numMismatches = 0;
+    os << "[routines]" << endl
+       << "process,routine,symbol,num blocks,num edges,num loops,irreducible edges,entry count"
+       << endl;
+    for (size_t ri = 0; ri < results.size(); ri++)
+    {
+        os << results[ri].routines;
+        numMismatches += results[ri].numMismatches;
+    }
+    os << endl
+       << "[loops]" << endl
+       << "process,head,parent,routine,symbol,depth,num blocks,num back edges,entry "
+          "count,iteration count"
+       << endl;
+    for (size_t ri = 0; ri < results.size(); ri++)
+        os << results[ri].loops;
+    if (print_idoms)
+    {
+        os << endl << "[idoms]" << endl << "process,node,idom,routine" << endl;
+        for (size_t ri = 0; ri < results.size(); ri++)
+            os << results[ri].idoms;
+    }
+
+    cerr << "Analyzed " << results.size() << " routines." << endl;
+    if (verify_loops)
+        cerr << numMismatches << " differences with the DCFG." << endl;
+
+    delete dcfg;
+    return numMismatches ? 1 : 0;
+}
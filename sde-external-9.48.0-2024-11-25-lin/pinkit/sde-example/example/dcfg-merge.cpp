@@ -0,0 +1,815 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+// Program to merge many DCFGs and to compare two groups of DCFGs.
+//
+// DCFG IDs are local to one file, so basic blocks are identified across
+// files by their image file name and their offset in the image. Edges are
+// identified by their source block, target block and type, and loops by
+// their head block. Counts of the same block, edge or loop are summed over
+// all the processes, threads and files.
+//
+// The files are read in parallel by forked loader processes. Every loader
+// releases each DCFG after summarizing it, so the memory does not grow
+// with the size of the DCFGs already read, and sends its summary to the
+// parent through a pipe.
+
+#include "dcfg_api.H"
+#include "sde-dcfg-edges.H"
+
+#include <stdlib.h>
+#include <assert.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <iomanip>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+
+using namespace std;
+using namespace dcfg_api;
+
+vector<string> base_files;
+vector<string> diff_files;
+char* out_file        = NULL;
+UINT32 num_jobs       = 4;
+UINT32 top_n          = 50;
+bool normalize_counts = false;
+bool diff_mode        = false;
+
+// Identity of a basic block across DCFG files.
+struct BlockKey
+{
+    string image;
+    UINT64 offset;
+
+    BlockKey() : offset(0) {}
+    BlockKey(const string& i, UINT64 o) : image(i), offset(o) {}
+
+    bool operator<(const BlockKey& other) const
+    {
+        if (offset != other.offset)
+            return offset < other.offset;
+        return image < other.image;
+    }
+};
+
+// Identity of an edge across DCFG files.
+struct EdgeKey
+{
+    BlockKey source;
+    BlockKey target;
+    string type;
+
+    bool operator<(const EdgeKey& other) const
+    {
+        if (source < other.source)
+            return true;
+        if (other.source < source)
+            return false;
+        if (target < other.target)
+            return true;
+        if (other.target < target)
+            return false;
+        return type < other.type;
+    }
+};
+
+// Counts summed per thread.
+class Counts
+{
+    vector<UINT64> _perThread;
+    UINT64 _total;
+
+  public:
+    Counts() : _total(0) {}
+
+    void add(UINT64 count) { _total += count; }
+
+    void addThread(UINT32 tid, UINT64 count)
+    {
+        if (tid >= _perThread.size())
+            _perThread.resize(tid + 1, 0);
+        _perThread[tid] += count;
+    }
+
+    void merge(const Counts& other)
+    {
+        _total += other._total;
+        for (UINT32 t = 0; t < other._perThread.size(); t++)
+            addThread(t, other._perThread[t]);
+    }
+
+    UINT64 total() const { return _total; }
+
+    void print(ostream& os) const
+    {
+        for (UINT32 t = 0; t < _perThread.size(); t++)
+            os << (t ? ";" : "") << _perThread[t];
+    }
+
+    void save(ostream& os) const
+    {
+        os << _total << ' ' << _perThread.size();
+        for (UINT32 t = 0; t < _perThread.size(); t++)
+            os << ' ' << _perThread[t];
+    }
+
+    void load(istream& is)
+    {
+        size_t n = 0;
+        is >> _total >> n;
+        _perThread.resize(n);
+        for (UINT32 t = 0; t < n; t++)
+            is >> _perThread[t];
+    }
+};
+
+struct BlockRec
+{
+    string symbol;
+    UINT32 numInstrs;
+    UINT32 numFiles; // number of DCFG files where the block was found
+    Counts execCount;
+
+    BlockRec() : numInstrs(0), numFiles(0) {}
+};
+
+struct EdgeRec
+{
+    Counts execCount;
+};
+
+struct LoopRec
+{
+    string symbol;
+    Counts entryCount;
+    Counts iterationCount;
+};
+
+// Blocks, edges and loops of one or more DCFGs.
+class DcfgSummary
+{
+  public:
+    map<BlockKey, BlockRec> blocks;
+    map<EdgeKey, EdgeRec> edges;
+    map<BlockKey, LoopRec> loops;
+    Counts instrCount;
+    UINT32 numFiles;
+    UINT32 numProcesses;
+
+    DcfgSummary() : numFiles(0), numProcesses(0) {}
+
+    // Key of a node, special nodes get an empty image name.
+    static BlockKey nodeKey(DCFG_PROCESS_CPTR pinfo, DCFG_ID nodeId)
+    {
+        if (pinfo->is_start_node(nodeId))
+            return BlockKey("", 0);
+        if (pinfo->is_end_node(nodeId))
+            return BlockKey("", 1);
+        if (pinfo->is_special_node(nodeId))
+            return BlockKey("", 2);
+
+        DCFG_BASIC_BLOCK_CPTR bb = pinfo->get_basic_block_info(nodeId);
+        assert(bb);
+        DCFG_IMAGE_CPTR iinfo = pinfo->get_image_info(bb->get_image_id());
+        if (!iinfo)
+            return BlockKey("", bb->get_first_instr_addr());
+        return BlockKey(*iinfo->get_filename(),
+                        bb->get_first_instr_addr() - iinfo->get_base_address());
+    }
+
+    void add(DCFG_DATA_CPTR dcfg)
+    {
+        numFiles++;
+        DCFG_ID_VECTOR proc_ids;
+        dcfg->get_process_ids(proc_ids);
+        for (size_t pi = 0; pi < proc_ids.size(); pi++)
+        {
+            DCFG_PROCESS_CPTR pinfo = dcfg->get_process_info(proc_ids[pi]);
+            assert(pinfo);
+            addProcess(pinfo);
+        }
+    }
+
+    void addProcess(DCFG_PROCESS_CPTR pinfo)
+    {
+        numProcesses++;
+        UINT32 numThreads = pinfo->get_highest_thread_id() + 1;
+        instrCount.add(pinfo->get_instr_count());
+        for (UINT32 t = 0; t < numThreads; t++)
+            instrCount.addThread(t, pinfo->get_instr_count_for_thread(t));
+
+        // Basic blocks and loops by image.
+        DCFG_ID_VECTOR image_ids;
+        pinfo->get_image_ids(image_ids);
+        for (size_t ii = 0; ii < image_ids.size(); ii++)
+        {
+            DCFG_IMAGE_CPTR iinfo = pinfo->get_image_info(image_ids[ii]);
+            assert(iinfo);
+
+            DCFG_ID_VECTOR bb_ids;
+            iinfo->get_basic_block_ids(bb_ids);
+            for (size_t bi = 0; bi < bb_ids.size(); bi++)
+            {
+                if (pinfo->is_special_node(bb_ids[bi]))
+                    continue;
+                DCFG_BASIC_BLOCK_CPTR bb = pinfo->get_basic_block_info(bb_ids[bi]);
+                assert(bb);
+
+                BlockRec& rec = blocks[nodeKey(pinfo, bb_ids[bi])];
+                if (!rec.numFiles++)
+                {
+                    const string* symbol = bb->get_symbol_name();
+                    rec.symbol           = symbol ? *symbol : "unknown";
+                    rec.numInstrs        = bb->get_num_instrs();
+                }
+                rec.execCount.add(bb->get_exec_count());
+                for (UINT32 t = 0; t < numThreads; t++)
+                    rec.execCount.addThread(t, bb->get_exec_count_for_thread(t));
+            }
+
+            DCFG_ID_VECTOR loop_ids;
+            iinfo->get_loop_ids(loop_ids);
+            for (size_t li = 0; li < loop_ids.size(); li++)
+            {
+                DCFG_LOOP_CPTR linfo = iinfo->get_loop_info(loop_ids[li]);
+                assert(linfo);
+
+                LoopRec& rec = loops[nodeKey(pinfo, loop_ids[li])];
+                if (rec.symbol.empty())
+                {
+                    DCFG_BASIC_BLOCK_CPTR head = pinfo->get_basic_block_info(loop_ids[li]);
+                    const string* symbol       = head ? head->get_symbol_name() : NULL;
+                    rec.symbol                 = symbol ? *symbol : "unknown";
+                }
+                rec.entryCount.add(linfo->get_entry_count());
+                rec.iterationCount.add(linfo->get_iteration_count());
+                for (UINT32 t = 0; t < numThreads; t++)
+                {
+                    rec.entryCount.addThread(t, linfo->get_entry_count_for_thread(t));
+                    rec.iterationCount.addThread(t, linfo->get_iteration_count_for_thread(t));
+                }
+            }
+        }
+
+        // Edges.
+        DCFG_ID_SET edge_ids;
+        INSTLIB::get_all_edge_ids(pinfo, edge_ids);
+        for (DCFG_ID_SET::const_iterator it = edge_ids.begin(); it != edge_ids.end(); it++)
+        {
+            DCFG_EDGE_CPTR edge = pinfo->get_edge_info(*it);
+            if (!edge)
+                continue;
+            EdgeKey key;
+            key.source        = nodeKey(pinfo, edge->get_source_node_id());
+            key.target        = nodeKey(pinfo, edge->get_target_node_id());
+            const string* ty  = edge->get_edge_type();
+            key.type          = ty ? *ty : "unknown";
+            EdgeRec& rec      = edges[key];
+            rec.execCount.add(edge->get_exec_count());
+            for (UINT32 t = 0; t < numThreads; t++)
+                rec.execCount.addThread(t, edge->get_exec_count_for_thread(t));
+        }
+    }
+
+    void merge(const DcfgSummary& other)
+    {
+        numFiles += other.numFiles;
+        numProcesses += other.numProcesses;
+        instrCount.merge(other.instrCount);
+        for (map<BlockKey, BlockRec>::const_iterator it = other.blocks.begin();
+             it != other.blocks.end(); it++)
+        {
+            BlockRec& rec = blocks[it->first];
+            if (!rec.numFiles)
+            {
+                rec.symbol    = it->second.symbol;
+                rec.numInstrs = it->second.numInstrs;
+            }
+            rec.numFiles += it->second.numFiles;
+            rec.execCount.merge(it->second.execCount);
+        }
+        for (map<EdgeKey, EdgeRec>::const_iterator it = other.edges.begin();
+             it != other.edges.end(); it++)
+            edges[it->first].execCount.merge(it->second.execCount);
+        for (map<BlockKey, LoopRec>::const_iterator it = other.loops.begin();
+             it != other.loops.end(); it++)
+        {
+            LoopRec& rec = loops[it->first];
+            if (rec.symbol.empty())
+                rec.symbol = it->second.symbol;
+            rec.entryCount.merge(it->second.entryCount);
+            rec.iterationCount.merge(it->second.iterationCount);
+        }
+    }
+
+    // Serialization between the loader processes and the parent.
+    // One record per line, strings are terminated by a tab.
+
+    static void saveKey(ostream& os, const BlockKey& key)
+    {
+        os << key.image << '\t' << key.offset << ' ';
+    }
+
+    static void loadKey(istream& is, BlockKey& key)
+    {
+        is.get();
+        getline(is, key.image, '\t');
+        is >> key.offset;
+    }
+
+    void save(ostream& os) const
+    {
+        os << "S " << numFiles << ' ' << numProcesses << ' ';
+        instrCount.save(os);
+        os << '\n';
+        for (map<BlockKey, BlockRec>::const_iterator it = blocks.begin(); it != blocks.end();
+             it++)
+        {
+            os << "B ";
+            saveKey(os, it->first);
+            os << it->second.symbol << '\t' << it->second.numInstrs << ' '
+               << it->second.numFiles << ' ';
+            it->second.execCount.save(os);
+            os << '\n';
+        }
+        for (map<EdgeKey, EdgeRec>::const_iterator it = edges.begin(); it != edges.end(); it++)
+        {
+            os << "E ";
+            saveKey(os, it->first.source);
+            saveKey(os, it->first.target);
+            os << it->first.type << '\t';
+            it->second.execCount.save(os);
+            os << '\n';
+        }
+        for (map<BlockKey, LoopRec>::const_iterator it = loops.begin(); it != loops.end();
+             it++)
+        {
+            os << "L ";
+            saveKey(os, it->first);
+            os << it->second.symbol << '\t';
+            it->second.entryCount.save(os);
+            os << ' ';
+            it->second.iterationCount.save(os);
+            os << '\n';
+        }
+    }
+
+    // Merge a summary saved by save().
+    bool load(istream& is)
+    {
+        DcfgSummary part;
+        char kind;
+        while (is >> kind)
+        {
+            if (kind == 'S')
+            {
+                is >> part.numFiles >> part.numProcesses;
+                part.instrCount.load(is);
+            }
+            else if (kind == 'B')
+            {
+                BlockKey key;
+                loadKey(is, key);
+                BlockRec& rec = part.blocks[key];
+                is.get();
+                getline(is, rec.symbol, '\t');
+                is >> rec.numInstrs >> rec.numFiles;
+                rec.execCount.load(is);
+            }
+            else if (kind == 'E')
+            {
+                EdgeKey key;
+                loadKey(is, key.source);
+                loadKey(is, key.target);
+                is.get();
+                getline(is, key.type, '\t');
+                part.edges[key].execCount.load(is);
+            }
+            else if (kind == 'L')
+            {
+                BlockKey key;
+                loadKey(is, key);
+                LoopRec& rec = part.loops[key];
+                is.get();
+                getline(is, rec.symbol, '\t');
+                rec.entryCount.load(is);
+                rec.iterationCount.load(is);
+            }
+            else
+                return false;
+            if (!is)
+                return false;
+        }
+        merge(part);
+        return true;
+    }
+};
+
+////// Parallel loading.
+
+// Read and summarize every num-th file starting with first.
+UINT32 loadFiles(const vector<string>& files, UINT32 first, UINT32 num, DcfgSummary& summary)
+{
+    UINT32 failed = 0;
+    for (size_t i = first; i < files.size(); i += num)
+    {
+        DCFG_DATA* dcfg = DCFG_DATA::new_dcfg();
+        string errMsg;
+        if (!dcfg->read(files[i], errMsg))
+        {
+            cerr << "error: '" << files[i] << "': " << errMsg << endl;
+            failed++;
+        }
+        else
+        {
+            summary.add(dcfg);
+        }
+        delete dcfg;
+    }
+    return failed;
+}
+
+bool writeAll(int fd, const string& data)
+{
+    size_t done = 0;
+    while (done < data.size())
+    {
+        ssize_t n = write(fd, data.data() + done, data.size() - done);
+        if (n <= 0)
+            return false;
+        done += n;
+    }
+    return true;
+}
+
+string readAll(int fd)
+{
+    string data;
+    char buf[64 * 1024];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0)
+        data.append(buf, n);
+    return data;
+}
+
+// Read and merge a group of DCFG files.
+bool loadGroup(const vector<string>& files, DcfgSummary& result)
+{
+    UINT32 numLoaders = min<UINT32>(num_jobs, files.size());
+    UINT32 failed     = 0;
+    if (numLoaders <= 1)
+    {
+        failed = loadFiles(files, 0, 1, result);
+    }
+    else
+    {
+        vector<int> fds(numLoaders);
+        vector<pid_t> pids(numLoaders);
+        for (UINT32 i = 0; i < numLoaders; i++)
+        {
+            int p[2];
+            if (pipe(p) != 0 || (pids[i] = fork()) < 0)
+            {
+                cerr << "error: cannot create loader process" << endl;
+                exit(1);
+            }
+            if (pids[i] == 0)
+            {
+                // Loader process: summarize its share and send the summary.
+                close(p[0]);
+                DcfgSummary summary;
+                loadFiles(files, i, numLoaders, summary);
+                ostringstream os;
+                summary.save(os);
+                bool ok = writeAll(p[1], os.str());
+                close(p[1]);
+                _exit(ok ? 0 : 1);
+            }
+            close(p[1]);
+            fds[i] = p[0];
+        }
+
+        for (UINT32 i = 0; i < numLoaders; i++)
+        {
+            istringstream is(readAll(fds[i]));
+            close(fds[i]);
+            int status = 0;
+            waitpid(pids[i], &status, 0);
+            if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || !result.load(is))
+            {
+                cerr << "error: loader process " << i << " failed" << endl;
+                exit(1);
+            }
+        }
+        // Only the files read successfully are counted in the summaries.
+        failed = files.size() - result.numFiles;
+    }
+    cerr << "Read " << files.size() - failed << " of " << files.size() << " DCFG files."
+         << endl;
+    return failed == 0;
+}
+
+////// Output.
+
+void printKey(ostream& os, const BlockKey& key)
+{
+    if (key.image.empty())
+    {
+        static const char* special[] = {"start", "end", "unknown"};
+        os << "\"[" << (key.offset < 3 ? special[key.offset] : "no image") << "]\",0x" << hex
+           << (key.offset < 3 ? 0 : key.offset) << dec;
+        return;
+    }
+    os << '"' << key.image << "\",0x" << hex << key.offset << dec;
+}
+
+template <typename REC>
+bool moreExecuted(const pair<const BlockKey*, const REC*>& a,
+                  const pair<const BlockKey*, const REC*>& b)
+{
+    return a.second->execCount.total() > b.second->execCount.total();
+}
+
+void printMerge(ostream& os, const DcfgSummary& s)
+{
+    os << "# Merged " << s.numFiles << " DCFG files, " << s.numProcesses << " processes"
+       << endl;
+    os << "# Instr count , " << s.instrCount.total() << endl;
+    os << "# Instr count per thread , ";
+    s.instrCount.print(os);
+    os << endl;
+
+    os << endl << "[blocks]" << endl;
+    os << "image,offset,symbol,num instrs,num files,exec count,instr count,exec count per thread"
+       << endl;
+    vector<pair<const BlockKey*, const BlockRec*> > blocks;
+    for (map<BlockKey, BlockRec>::const_iterator it = s.blocks.begin(); it != s.blocks.end();
+         it++)
+        blocks.push_back(make_pair(&it->first, &it->second));
+    stable_sort(blocks.begin(), blocks.end(), moreExecuted<BlockRec>);
+    for (size_t i = 0; i < blocks.size(); i++)
+    {
+        const BlockRec* rec = blocks[i].second;
+        printKey(os, *blocks[i].first);
+        os << ",\"" << rec->symbol << "\"," << rec->numInstrs << "," << rec->numFiles << ","
+           << rec->execCount.total() << "," << rec->execCount.total() * rec->numInstrs << ",";
+        rec->execCount.print(os);
+        os << endl;
+    }
+
+    os << endl << "[edges]" << endl;
+    os << "source image,source offset,target image,target offset,type,exec count,"
+          "exec count per thread"
+       << endl;
+    for (map<EdgeKey, EdgeRec>::const_iterator it = s.edges.begin(); it != s.edges.end(); it++)
+    {
+        printKey(os, it->first.source);
+        os << ",";
+        printKey(os, it->first.target);
+        os << "," << it->first.type << "," << it->second.execCount.total() << ",";
+        it->second.execCount.print(os);
+        os << endl;
+    }
+
+    os << endl << "[loops]" << endl;
+    os << "head image,head offset,symbol,entry count,iteration count,"
+          "iteration count per thread"
+       << endl;
+    for (map<BlockKey, LoopRec>::const_iterator it = s.loops.begin(); it != s.loops.end(); it++)
+    {
+        printKey(os, it->first);
+        os << ",\"" << it->second.symbol << "\"," << it->second.entryCount.total() << ","
+           << it->second.iterationCount.total() << ",";
+        it->second.iterationCount.print(os);
+        os << endl;
+    }
+}
+
+// Change of one count between the two groups.
+struct Change
+{
+    string row; // key and description
+    double base;
+    double diff;
+
+    double delta() const { return diff - base; }
+
+    static bool larger(const Change& a, const Change& b)
+    {
+        double da = a.delta() < 0 ? -a.delta() : a.delta();
+        double db = b.delta() < 0 ? -b.delta() : b.delta();
+        return da > db;
+    }
+};
+
+template <typename KEY, typename REC, typename GET>
+vector<Change> compare(const map<KEY, REC>& base, const map<KEY, REC>& diff, GET get,
+                       double scale, void (*describe)(ostream&, const KEY&, const REC&))
+{
+    vector<Change> changes;
+    typename map<KEY, REC>::const_iterator bi = base.begin(), di = diff.begin();
+    while (bi != base.end() || di != diff.end())
+    {
+        Change c;
+        ostringstream os;
+        if (di == diff.end() || (bi != base.end() && bi->first < di->first))
+        {
+            describe(os, bi->first, bi->second);
+            c.base = double(get(bi->second));
+            c.diff = 0;
+            bi++;
+        }
+        else if (bi == base.end() || di->first < bi->first)
+        {
+            describe(os, di->first, di->second);
+            c.base = 0;
+            c.diff = double(get(di->second)) * scale;
+            di++;
+        }
+        else
+        {
+            describe(os, di->first, di->second);
+            c.base = double(get(bi->second));
+            c.diff = double(get(di->second)) * scale;
+            bi++;
+            di++;
+        }
+        c.row = os.str();
+        if (c.delta() != 0)
+            changes.push_back(c);
+    }
+    stable_sort(changes.begin(), changes.end(), Change::larger);
+    if (changes.size() > top_n)
+        changes.resize(top_n);
+    return changes;
+}
+
+void describeBlock(ostream& os, const BlockKey& key, const BlockRec& rec)
+{
+    printKey(os, key);
+    os << ",\"" << rec.symbol << "\"";
+}
+
+void describeEdge(ostream& os, const EdgeKey& key, const EdgeRec& rec)
+{
+    printKey(os, key.source);
+    os << ",";
+    printKey(os, key.target);
+    os << "," << key.type;
+}
+
+void describeLoop(ostream& os, const BlockKey& key, const LoopRec& rec)
+{
+    printKey(os, key);
+    os << ",\"" << rec.symbol << "\"";
+}
+
+UINT64 blockExecCount(const BlockRec& rec) { return rec.execCount.total(); }
+UINT64 edgeExecCount(const EdgeRec& rec) { return rec.execCount.total(); }
+UINT64 loopIterationCount(const LoopRec& rec) { return rec.iterationCount.total(); }
+
+void printChanges(ostream& os, const char* section, const char* header,
+                  const vector<Change>& changes)
+{
+    os << endl << "[" << section << "]" << endl;
+    os << header << ",base count,diff count,change,relative change" << endl;
+    for (size_t i = 0; i < changes.size(); i++)
+    {
+        const Change& c = changes[i];
+        os << c.row << "," << c.base << "," << c.diff << "," << c.delta() << ",";
+        if (c.base)
+            os << c.delta() / c.base;
+        else
+            os << "new";
+        os << endl;
+    }
+}
+
+void printDiff(ostream& os, const DcfgSummary& base, const DcfgSummary& diff)
+{
+    double scale = 1;
+    if (normalize_counts && diff.instrCount.total())
+        scale = double(base.instrCount.total()) / diff.instrCount.total();
+
+    os << setprecision(4) << fixed;
+    os << "# Base: " << base.numFiles << " DCFG files, instr count , "
+       << base.instrCount.total() << endl;
+    os << "# Diff: " << diff.numFiles << " DCFG files, instr count , "
+       << diff.instrCount.total() << endl;
+    if (normalize_counts)
+        os << "# Diff counts scaled by , " << scale << endl;
+
+    printChanges(os, "blocks", "image,offset,symbol",
+                 compare(base.blocks, diff.blocks, blockExecCount, scale, describeBlock));
+    printChanges(os, "loops", "head image,head offset,symbol",
+                 compare(base.loops, diff.loops, loopIterationCount, scale, describeLoop));
+    printChanges(os, "edges",
+                 "source image,source offset,target image,target offset,type",
+                 compare(base.edges, diff.edges, edgeExecCount, scale, describeEdge));
+}
+
+// Print usage and exit.
+void usage(const char* cmd)
+{
+    cerr << "This program merges DCFG files in JSON format and outputs the blocks, edges and"
+         << endl
+         << "loops with their counts summed over all the files, processes and threads."
+         << endl
+         << "With -diff, it compares the merged DCFGs before -diff with the merged DCFGs"
+         << endl
+         << "after it and outputs the blocks, loops and edges with the largest changes."
+         << endl
+         << "Usage:" << endl
+         << cmd
+         << " [ -o <out-file> ] [ -j <num-threads> ] [ -top <n> ] [ -normalize ] "
+            "<dcfg-file>... [ -diff <dcfg-file>... ]"
+         << endl;
+    exit(1);
+}
+
+void parse_args(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++) // skip argv[0], the program name
+    {
+        string arg(argv[i]);
+        if (arg == "-o" || arg == "-j" || arg == "-top")
+        {
+            if ((i + 1) == argc)
+            {
+                cerr << "Must provide a value after '" << arg << "'." << endl;
+                usage(argv[0]);
+            }
+            i++;
+            if (arg == "-o")
+                out_file = argv[i];
+            else if (arg == "-j")
+                num_jobs = atoi(argv[i]);
+            else
+                top_n = atoi(argv[i]);
+        }
+        else if (arg == "-normalize")
+            normalize_counts = true;
+        else if (arg == "-diff")
+            diff_mode = true;
+        else if (arg[0] == '-')
+        {
+            cerr << "Unknown option " << arg << endl;
+            usage(argv[0]);
+        }
+        else if (diff_mode)
+            diff_files.push_back(arg);
+        else
+            base_files.push_back(arg);
+    }
+    if (num_jobs == 0)
+        num_jobs = 1;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2)
+        usage(argv[0]);
+
+    parse_args(argc, argv);
+
+    if (base_files.empty() || (diff_mode && diff_files.empty()))
+    {
+        cerr << "Missing dcfg files. " << endl;
+        usage(argv[0]);
+    }
+
+    ofstream fos;
+    if (out_file)
+    {
+        fos.open(out_file, ios_base::out);
+        if (!fos.is_open())
+        {
+            cerr << "Error: cannot open '" << out_file << "' for writing." << endl;
+            return 1;
+        }
+    }
+    ostream& os = out_file ? fos : cout;
+
+    DcfgSummary base;
+    bool ok = loadGroup(base_files, base);
+    if (diff_mode)
+    {
+        DcfgSummary diff;
+        ok = loadGroup(diff_files, diff) && ok;
+        printDiff(os, base, diff);
+    }
+    else
+    {
+        printMerge(os, base);
+    }
+
+    return ok ? 0 : 1;
+}
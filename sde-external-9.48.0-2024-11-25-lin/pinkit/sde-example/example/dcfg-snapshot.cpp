@@ -0,0 +1,41 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that writes a snapshot of the Dynamic Control
+  Flow Graph (DCFG) of the application at the end of every controller region,
+  e.g.:
+    sde64 -t dcfg-snapshot.so -control start:icount:1,stop:icount:1000000000,repeat
+          -- <application>
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "dcfg_pin_api.H"
+#include "dcfg-snapshot.H"
+
+using namespace dcfg_pin_api;
+
+dcfg_snapshot::DCFG_SNAPSHOT dcfgSnapshot;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate DCFG generation, the snapshots need it even without the
+    // '-dcfg' knob.
+    DCFG_PIN_MANAGER* dcfgMgr = DCFG_PIN_MANAGER::new_manager();
+    dcfgMgr->activate();
+
+    // Activate the snapshots.
+    dcfgSnapshot.activate(dcfgMgr);
+
+    PIN_StartProgram(); // Never returns
+    delete dcfgMgr;
+    return 0;
+}
@@ -0,0 +1,30 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that profiles the distances between the
+  elements of gather instructions with bounded memory, e.g.:
+    sde64 -t gather-sketch.so -- <application>
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "gather-sketch.H"
+
+gather_sketch::GATHER_SKETCH gatherSketch;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate gather profiling.
+    gatherSketch.activate();
+
+    PIN_StartProgram(); // Never returns
+    return 0;
+}
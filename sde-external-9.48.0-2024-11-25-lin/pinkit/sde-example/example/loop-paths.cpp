@@ -0,0 +1,42 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that profiles the acyclic paths through the
+  loops of an input Dynamic Control Flow Graph (DCFG), e.g.:
+    sde64 -t loop-paths.so -loop-paths:dcfg-file <name>.dcfg.json.bz2
+          -- <application>
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "dcfg_pin_api.H"
+#include "loop-paths.H"
+
+using namespace dcfg_pin_api;
+
+loop_paths::LOOP_PATHS loopPaths;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate DCFG generation if enabling knob was used.
+    DCFG_PIN_MANAGER* dcfgMgr = DCFG_PIN_MANAGER::new_manager();
+    if (dcfgMgr->dcfg_enable_knob())
+    {
+        dcfgMgr->activate();
+    }
+
+    // Activate path profiling.
+    loopPaths.activate();
+
+    PIN_StartProgram(); // Never returns
+    delete dcfgMgr;
+    return 0;
+}
@@ -52,6 +52,9 @@ int main(int argc, char* argv[])
     // Activate loop tracking.
     loopProfiler.activate();
 
+    // Activate the telemetry of the analysis routines if enabled.
+    analysis_telemetry::telemetry.activate();
+
     PIN_StartProgram(); // Never returns
     return 0;
 }
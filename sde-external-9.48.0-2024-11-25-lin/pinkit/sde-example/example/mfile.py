@@ -100,14 +100,18 @@ dag = mbuild.dag_t(env=env)
 tools = ['example','agen-example','example-replay',
          'controller-example','reg-example', 'example-procinfo',
          'example-zlib', 'amx-example','pcregions_control',
-         'apx-example' ]
+         'apx-example', 'tsx-conflict', 'cet-shadow-stack',
+         'avx-sse-transition', 'gather-sketch', 'ptr-checker', 'mrc',
+         'block-vectors', 'cond-break',
+         'chip-legality' ]
 if env.on_linux():
-    tools.extend(['looppoint','loop-tracker','loop-profiler'])     
+    tools.extend(['looppoint','loop-tracker','loop-profiler','dcfg-snapshot','loop-paths',
+                  'dcfg-edge-trace'])     
 
 # Standalone programs
 programs = {}
 if env.on_linux():
-    programs = ['dcfg-reader']
+    programs = ['dcfg-reader', 'dcfg-merge', 'dcfg-loops', 'dcfg-edge-region', 'mux-split']
 
 # Always support pinplay
 mbuild.msgb('PINPLAY IS BEING USED')
@@ -137,15 +141,31 @@ tool_sources['amx-example'] =  ['amx-example.cpp']
 tool_sources['apx-example'] =  ['apx-example.cpp']
 tool_sources['example-zlib'] =  ['example-zlib.cpp']
 tool_sources['pcregions_control'] =  ['pcregions_control.cpp']
+tool_sources['tsx-conflict'] =  ['tsx-conflict.cpp']
+tool_sources['cet-shadow-stack'] =  ['cet-shadow-stack.cpp']
+tool_sources['avx-sse-transition'] =  ['avx-sse-transition.cpp']
+tool_sources['gather-sketch'] =  ['gather-sketch.cpp']
+tool_sources['ptr-checker'] =  ['ptr-checker.cpp']
+tool_sources['mrc'] =  ['mrc.cpp']
+tool_sources['block-vectors'] =  ['block-vectors.cpp']
+tool_sources['cond-break'] =  ['cond-break.cpp']
+tool_sources['chip-legality'] =  ['chip-legality.cpp']
 if env.on_linux():
     tool_sources['looppoint'] =  ['looppoint.cpp']
     tool_sources['loop-tracker'] =  ['loop-tracker.cpp']
     tool_sources['loop-profiler'] =  ['loop-profiler.cpp']
+    tool_sources['dcfg-snapshot'] =  ['dcfg-snapshot.cpp']
+    tool_sources['loop-paths'] =  ['loop-paths.cpp']
+    tool_sources['dcfg-edge-trace'] =  ['dcfg-edge-trace.cpp']
 
 # Programs sources
 programs_sources = {}
 if env.on_linux():
     programs_sources['dcfg-reader'] =  ['dcfg-reader.cpp']
+    programs_sources['dcfg-merge'] =  ['dcfg-merge.cpp']
+    programs_sources['dcfg-loops'] =  ['dcfg-loops.cpp']
+    programs_sources['dcfg-edge-region'] =  ['dcfg-edge-region.cpp']
+    programs_sources['mux-split'] =  ['mux-split.cpp']
 
 # Build tools
 for tool in tools:
@@ -0,0 +1,30 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that writes the miss ratio curves of all
+  cache sizes per controller region and per slice, e.g.:
+    sde64 -t mrc.so -mrc:slice-size 100000000 -- <application>
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "mrc.H"
+
+miss_ratio_curve::MRC_PROFILER mrcProfiler;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate the miss ratio curves.
+    mrcProfiler.activate();
+
+    PIN_StartProgram(); // Never returns
+    return 0;
+}
@@ -0,0 +1,160 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+// Recreate the files of the streams multiplexed into containers by
+// OUTPUT_MUX (sde-output-mux.H):
+//   mux-split [-o <directory>] <base>.0.mux [<base>.1.mux ...]
+
+#include "sde-output-mux-format.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+
+using namespace std;
+
+// Files are opened for appending when they have data, and all closed when
+// too many are open, so that any number of streams can be split.
+static const size_t MAX_OPEN_FILES = 256;
+
+class SPLITTER
+{
+    string dir;
+    map<sde_uint32_t, string> names;
+    set<string> created;
+    map<sde_uint32_t, ofstream*> files;
+
+    void closeAll()
+    {
+        for (map<sde_uint32_t, ofstream*>::iterator it = files.begin(); it != files.end(); ++it)
+            delete it->second;
+        files.clear();
+    }
+
+    ofstream* file(sde_uint32_t stream)
+    {
+        map<sde_uint32_t, ofstream*>::iterator it = files.find(stream);
+        if (it != files.end())
+            return it->second;
+        if (files.size() >= MAX_OPEN_FILES)
+            closeAll();
+        const string& name = names[stream];
+        ios::openmode mode = ios::out | ios::binary;
+        if (created.count(name))
+            mode |= ios::app;
+        ofstream* out = new ofstream(name.c_str(), mode);
+        if (!out->is_open())
+        {
+            cerr << "Error: cannot open " << name << endl;
+            exit(1);
+        }
+        created.insert(name);
+        files[stream] = out;
+        return out;
+    }
+
+  public:
+    explicit SPLITTER(const string& dir) : dir(dir) {}
+    ~SPLITTER() { closeAll(); }
+
+    void split(const char* container)
+    {
+        ifstream in(container, ios::in | ios::binary);
+        char magic[SDE_MUX_MAGIC_SIZE];
+        if (!in.read(magic, sizeof(magic)) || memcmp(magic, SDE_MUX_MAGIC, sizeof(magic)))
+        {
+            cerr << "Error: " << container << " is not an output container" << endl;
+            exit(1);
+        }
+
+        string data;
+        for (;;)
+        {
+            sde_mux_record_header_t header;
+            if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)))
+            {
+                if (in.gcount())
+                {
+                    cerr << "Error: truncated record in " << container << endl;
+                    exit(1);
+                }
+                break;
+            }
+            sde_uint32_t stream = header.stream;
+            sde_uint64_t size   = header.size;
+            data.resize(size);
+            if (size && !in.read(&data[0], size))
+            {
+                cerr << "Error: truncated record in " << container << endl;
+                exit(1);
+            }
+
+            switch (header.type)
+            {
+            case SDE_MUX_NAME:
+                if (!dir.empty())
+                {
+                    string::size_type slash = data.find_last_of('/');
+                    data = dir + "/" + (slash == string::npos ? data : data.substr(slash + 1));
+                }
+                names[stream] = data;
+                // A stream without data still makes its (empty) file.
+                file(stream);
+                break;
+            case SDE_MUX_DATA:
+                if (!names.count(stream))
+                {
+                    cerr << "Error: data of unnamed stream " << stream << " in " << container
+                         << endl;
+                    exit(1);
+                }
+                file(stream)->write(data.data(), size);
+                break;
+            case SDE_MUX_CLOSE:
+            {
+                map<sde_uint32_t, ofstream*>::iterator it = files.find(stream);
+                if (it != files.end())
+                {
+                    delete it->second;
+                    files.erase(it);
+                }
+                break;
+            }
+            default:
+                cerr << "Error: bad record type " << header.type << " in " << container << endl;
+                exit(1);
+            }
+        }
+    }
+
+    size_t numStreams() const { return names.size(); }
+};
+
+int main(int argc, char* argv[])
+{
+    string dir;
+    int first = 1;
+    if (argc > 2 && strcmp(argv[1], "-o") == 0)
+    {
+        dir   = argv[2];
+        first = 3;
+    }
+    if (first >= argc)
+    {
+        cerr << "Usage: " << argv[0] << " [-o <directory>] <container>..." << endl;
+        return 1;
+    }
+
+    SPLITTER splitter(dir);
+    for (int i = first; i < argc; i++)
+        splitter.split(argv[i]);
+    cout << "Recreated " << splitter.numStreams() << " files" << endl;
+    return 0;
+}
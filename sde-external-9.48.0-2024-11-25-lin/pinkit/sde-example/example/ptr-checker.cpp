@@ -0,0 +1,30 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that checks the memory references of emulated
+  instructions for bad pointers and misalignment, e.g.:
+    sde64 -t ptr-checker.so -- <application>
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "ptr-checker.H"
+
+ptr_checker::PTR_CHECKER ptrChecker;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate pointer checking.
+    ptrChecker.activate();
+
+    PIN_StartProgram(); // Never returns
+    return 0;
+}
@@ -0,0 +1,31 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+  This file creates an SDE tool that detects conflicts between RTM
+  transactions using per-thread address signatures.
+  Run it together with the RTM emulation, e.g.:
+    sde64 -rtm_mode full -t tsx-conflict.so -- <application>
+*/
+
+#include "pin.H"
+#include "sde-init.H"
+#include "tsx-conflict.H"
+
+tsx_conflict::TSX_CONFLICT tsxConflict;
+
+int main(int argc, char* argv[])
+{
+    PIN_InitSymbols();
+
+    sde_pin_init(argc, argv);
+    sde_init();
+
+    // Activate conflict detection.
+    tsxConflict.activate();
+
+    PIN_StartProgram(); // Never returns
+    return 0;
+}
@@ -0,0 +1,36 @@
+//
+// Copyright (C) 2024 Intel Corporation.
+// SPDX-License-Identifier: MIT
+//
+
+/*
+ Format of the container files of OUTPUT_MUX (sde-output-mux.H), shared
+ with the mux-split program. A container is the magic followed by
+ records: a header, and the name (SDE_MUX_NAME) or data (SDE_MUX_DATA) of
+ the stream, size bytes; SDE_MUX_CLOSE records have no bytes. The fields
+ are in the byte order of the host.
+*/
+
+#if !defined(_SDE_OUTPUT_MUX_FORMAT_H_)
+#define _SDE_OUTPUT_MUX_FORMAT_H_
+
+#include "sde-c-base-types.h"
+
+#define SDE_MUX_MAGIC      "SDEMUX1\n"
+#define SDE_MUX_MAGIC_SIZE 8
+
+typedef enum
+{
+    SDE_MUX_NAME,
+    SDE_MUX_DATA,
+    SDE_MUX_CLOSE
+} sde_mux_record_type_t;
+
+typedef struct
+{
+    sde_uint32_t stream;
+    sde_uint32_t type;
+    sde_uint64_t size;
+} sde_mux_record_header_t;
+
+#endif